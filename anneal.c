@@ -0,0 +1,540 @@
+
+
+/* project includes */
+#include "main.h"
+
+
+/************************************************************/
+/* annealing local search:  keeps a complete (cyclic) ordering of all
+ * vertices, and tries to reduce the number of consecutive pairs in the
+ * ordering that are not joined by an edge (the cost).  an ordering of
+ * cost 0 is a hamiltonian cycle.
+ *
+ * order[] is indexed by position in the ordering, and gives the vertex
+ * pos[] is indexed by vertex, and gives its position in the ordering
+ */
+/************************************************************/
+
+/* 1 if vertices x and y are consecutive in the ordering but not adjacent */
+#define ANNEAL_NONEDGE(adj,x,y) (CHECK_ADJMATRIX(adj,x,y) ? 0 : 1)
+
+
+/************************************************************/
+/* this function builds the starting ordering for the local search.
+ * a random walk is used:  from the last vertex placed, go to an unplaced
+ * neighbour if there is one, otherwise jump to a random unplaced vertex.
+ * returns the cost (# of non-edges) of the ordering.
+ */
+int
+anneal_init_order(
+  graph_type *graph,
+  adjmatrix_type *adj,
+  int order[],
+  int pos[])
+{
+  int jumplist[MAXVERT];
+  int jumpnext;
+  int numplaced;
+  int curvert, nextvert;
+  int loop, eloop, start;
+  int tmp;
+  int cost;
+
+  /* random order in which to pick vertices when the walk gets stuck */
+  for (loop = 0; loop < graph->numvert; loop++)
+  {
+    jumplist[loop] = loop;
+    pos[loop] = -1;
+  }
+  for (loop = 0; loop < graph->numvert - 1; loop++)
+  {
+    eloop = loop + (int) (lrand48() % (graph->numvert - loop));
+    tmp = jumplist[loop];
+    jumplist[loop] = jumplist[eloop];
+    jumplist[eloop] = tmp;
+  }
+
+  curvert = jumplist[0];
+  jumpnext = 1;
+  order[0] = curvert;
+  pos[curvert] = 0;
+
+  for (numplaced = 1; numplaced < graph->numvert; numplaced++)
+  {
+    /* look for an unplaced neighbour, starting at a random neighbour */
+    nextvert = -1;
+    start = lrand48() % graph->deg[curvert];
+    eloop = start;
+    do
+    {
+      if (pos[graph->nbr[curvert][eloop]] == -1)
+      {
+        nextvert = graph->nbr[curvert][eloop];
+        break;
+      }
+      eloop = (eloop+1) % graph->deg[curvert];
+    } while (eloop != start);
+
+    /* stuck, so jump to next unplaced vertex in the random list */
+    if (nextvert == -1)
+    {
+      while (pos[jumplist[jumpnext]] != -1)
+        jumpnext++;
+      nextvert = jumplist[jumpnext];
+    }
+
+    order[numplaced] = nextvert;
+    pos[nextvert] = numplaced;
+    curvert = nextvert;
+  }
+
+  /* calculate cost */
+  for (cost = 0, loop = 0; loop < graph->numvert; loop++)
+  {
+    cost += ANNEAL_NONEDGE(adj, order[loop],
+		order[(loop+1) % graph->numvert]);
+  }
+
+  return(cost);
+
+}  /* end of anneal_init_order() */
+
+
+/************************************************************/
+/* this function reverses the section of the cyclic ordering from
+ * position first to position last (inclusive).  the section may wrap
+ * around the end of the order[] array.
+ */
+void
+anneal_reverse_segment(
+  int order[],
+  int pos[],
+  int numvert,
+  int first,
+  int last)
+{
+  int len;
+  int loop;
+  int tmp;
+
+  len = last - first;
+  if (len < 0)
+    len += numvert;
+  len++;
+
+  for (loop = 0; loop < len/2; loop++)
+  {
+    tmp = order[first];
+    order[first] = order[last];
+    order[last] = tmp;
+    pos[order[first]] = first;
+    pos[order[last]] = last;
+
+    if (++first == numvert) first = 0;
+    if (--last < 0) last = numvert-1;
+  }
+
+}  /* end of anneal_reverse_segment() */
+
+
+/************************************************************/
+/* this function decides whether to accept a move which changes the cost
+ * by delta, at the current temperature
+ */
+int
+anneal_accept(
+  int delta,
+  float temp)
+{
+  if (delta <= 0)
+    return(1);
+
+  return( drand48() < exp( - (double) delta / (double) temp) );
+
+}  /* end of anneal_accept() */
+
+
+/************************************************************/
+/* 2-opt move for the non-edge between positions i and i+1 (vertices a,b):
+ * pick a random neighbour c of a (followed by d in the ordering) and
+ * reverse the section b...c, so that the ordering has the edge a-c.
+ *   ie:  from  a b ... c d   to   a c ... b d
+ * the cost changes by the (non-)edges b-d, a-b and c-d only, so the
+ * change is known before the move is made.
+ * returns the change in cost (0 if the move was not made)
+ */
+int
+anneal_2opt_move(
+  graph_type *graph,
+  adjmatrix_type *adj,
+  int order[],
+  int pos[],
+  int i,
+  float temp)
+{
+  int n = graph->numvert;
+  int a, b, c, d;
+  int inext, j, jnext;
+  int delta;
+  int seglen;
+
+  inext = (i+1) % n;
+  a = order[i];
+  b = order[inext];
+  c = graph->nbr[a][lrand48() % graph->deg[a]];
+  j = pos[c];
+  jnext = (j+1) % n;
+  d = order[jnext];
+
+  /* c already precedes a, so nothing to gain */
+  if (d == a)
+    return(0);
+
+  delta = ANNEAL_NONEDGE(adj, b, d) - 1 - ANNEAL_NONEDGE(adj, c, d);
+
+  if (!anneal_accept(delta, temp))
+    return(0);
+
+  /* reverse whichever of b...c or d...a is shorter (same cycle either way) */
+  seglen = j - inext;
+  if (seglen < 0)
+    seglen += n;
+
+  if (2*seglen < n)
+    anneal_reverse_segment(order, pos, n, inext, j);
+  else
+    anneal_reverse_segment(order, pos, n, jnext, i);
+
+  return(delta);
+
+}  /* end of anneal_2opt_move() */
+
+
+/************************************************************/
+/* or-opt move for the non-edge between positions i and i+1 (vertices a,b):
+ * take b (followed by e) out of the ordering, and put it back between a
+ * random neighbour x of b and the vertex y following x.
+ *   ie:  from  a b e ... x y   to   a e ... x b y
+ * returns the change in cost (0 if the move was not made)
+ */
+int
+anneal_oropt_move(
+  graph_type *graph,
+  adjmatrix_type *adj,
+  int order[],
+  int pos[],
+  int i,
+  float temp)
+{
+  int n = graph->numvert;
+  int a, b, e, x, y;
+  int bpos, xpos, ypos;
+  int delta;
+  int loop, dist;
+
+  bpos = (i+1) % n;
+  a = order[i];
+  b = order[bpos];
+  e = order[(bpos+1) % n];
+  x = graph->nbr[b][lrand48() % graph->deg[b]];
+  xpos = pos[x];
+  ypos = (xpos+1) % n;
+  y = order[ypos];
+
+  /* b is already next to x, or would go back where it was */
+  if ( (x == a) || (y == b) )
+    return(0);
+
+  delta = ANNEAL_NONEDGE(adj, a, e) + ANNEAL_NONEDGE(adj, b, y)
+	- 1 - ANNEAL_NONEDGE(adj, b, e) - ANNEAL_NONEDGE(adj, x, y);
+
+  if (!anneal_accept(delta, temp))
+    return(0);
+
+  /* shift the vertices between b and x (or between y and b) along by one,
+   * whichever is fewer, and put b into the gap
+   */
+  dist = xpos - bpos;
+  if (dist < 0)
+    dist += n;
+
+  if (2*dist < n)
+  {
+    for (loop = bpos; loop != xpos; loop = (loop+1) % n)
+    {
+      order[loop] = order[(loop+1) % n];
+      pos[order[loop]] = loop;
+    }
+    order[xpos] = b;
+    pos[b] = xpos;
+  }
+  else
+  {
+    for (loop = bpos; loop != ypos; loop = (loop+n-1) % n)
+    {
+      order[loop] = order[(loop+n-1) % n];
+      pos[order[loop]] = loop;
+    }
+    order[ypos] = b;
+    pos[b] = ypos;
+  }
+
+  return(delta);
+
+}  /* end of anneal_oropt_move() */
+
+
+/************************************************************/
+/* main body of the annealing local search
+ *   does initial degree checking/component checking using pruning
+ *   runs the local search on the pruned graph until the ordering is
+ *   a cycle, the move limit is reached or the time limit is reached
+ *     returns solution (ordering of vertices making up the hamiltonian cycle)
+ *     (if solution was found)
+ *
+ *   returns HC_FOUND if HC found, HC_NOT_EXIST if a cycle cannot possibly
+ *     exist on this graph, and HC_NOT_FOUND if a cycle was not found
+ *
+ *   the nodes statistic is set to the number of moves per second, and
+ *   the retries statistic to the number of reheats
+ */
+int
+master_anneal_alg(
+  graph_type *graph,
+  stat_pertrial_type *trialstats,
+  int solution[])
+{
+  int ret;
+  int prune = 0;
+  graph_type testgraph;
+  adjmatrix_type adj;
+
+  int order[MAXVERT];
+  int pos[MAXVERT];
+  int cost;
+  int i, start;
+  long moves, maxmoves;
+  int reheats = 0;
+  float temp;
+  float elapsed;
+
+  /* update statistics */
+  trialstats->edgeprune = 0;
+  trialstats->nodes = 0;
+  trialstats->retries = 0;
+
+  /* copy passed in graph to second graph data structure
+   * so that original graph isn't overwritten when pruning, etc.
+   */
+  PHASE_START(PHASE_COPY);
+  copy_graph(graph, &testgraph);
+  PHASE_STOP(PHASE_COPY);
+
+  /* do initial H.C. pruning, and run tests to see if H.C. can exist */
+  PHASE_START(PHASE_INITPRUNE);
+  ret = hc_do_pruning(&testgraph, &prune, HC_PRUNE_ALL, NULL);
+  PHASE_STOP(PHASE_INITPRUNE);
+  trialstats->edgeprune = prune;
+
+  if (ret == HC_NOT_EXIST)
+  {
+    return(HC_NOT_EXIST);
+  }
+
+  calc_graph_adjmatrix(&testgraph, &adj);
+  cost = anneal_init_order(&testgraph, &adj, order, pos);
+
+  maxmoves = (long) g_options.anneal_alg.maxmoves * testgraph.numvert;
+  temp = g_options.anneal_alg.inittemp;
+  moves = 0;
+
+  PHASE_START(PHASE_SEARCH);
+  while ( (cost > 0) && (moves < maxmoves) )
+  {
+    /* find a non-edge in the ordering, starting at a random position */
+    start = lrand48() % testgraph.numvert;
+    i = start;
+    while (!ANNEAL_NONEDGE(&adj, order[i], order[(i+1) % testgraph.numvert]))
+    {
+      i = (i+1) % testgraph.numvert;
+    }
+
+    if (lrand48() & 1)
+      cost += anneal_2opt_move(&testgraph, &adj, order, pos, i, temp);
+    else
+      cost += anneal_oropt_move(&testgraph, &adj, order, pos, i, temp);
+
+    moves++;
+
+    /* cool down, and reheat if the search has frozen */
+    if (moves % testgraph.numvert == 0)
+    {
+      temp *= g_options.anneal_alg.cooling;
+      if (temp < ANNEAL_MINTEMP)
+      {
+        temp = g_options.anneal_alg.inittemp;
+        reheats++;
+      }
+    }
+
+    if (moves % ANNEAL_TIMECHECK == 0)
+    {
+      PROGRESS_STORE(nodes, moves);
+      /* the "path length" is the # of consecutive pairs that are edges */
+      PROGRESS_STORE(pathlen, testgraph.numvert - cost);
+      if (testgraph.numvert - cost > PROGRESS_LOAD(maxpath))
+        PROGRESS_STORE(maxpath, testgraph.numvert - cost);
+      PROGRESS_STORE(restart, reheats);
+      if (hc_check_timelimit() == HC_QUIT)
+        break;
+    }
+  }
+  PHASE_STOP(PHASE_SEARCH);
+
+  /* update statistics:  report moves per second as the node count */
+  elapsed = hc_get_elapsed_time();
+  if (elapsed > 0.0)
+    trialstats->nodes = (int) (moves / elapsed);
+  else
+    trialstats->nodes = moves;
+  trialstats->retries = reheats;
+
+  if (g_options.report_flags & REPORT_ALG)
+  {
+    fprintf(g_options.log_fp, "Annealing made %ld moves (%d per second), "
+	"%d reheats, final cost %d.\n", moves, trialstats->nodes, reheats, cost);
+  }
+
+  if (cost > 0)
+    return(HC_NOT_FOUND);
+
+  for (i = 0; i < testgraph.numvert; i++)
+    solution[i] = order[i];
+
+  return(HC_FOUND);
+
+}  /* end of master_anneal_alg() */
+
+
+/************************************************************/
+/* annealing algorithm option routines, for handling the options
+ * associated with the annealing local search
+ */
+/************************************************************/
+
+/************************************************************/
+/* this function parses the option file for parameters for using
+ * the annealing local search.
+ *
+ * input parameters:  word : the argument
+ *                      fp : file pointer to file, set to the parameters of
+ *                           the argument
+ * output parameters: word : the next argument/comment (non-parameter) word
+ *                  return : the status of the most recent read
+ *
+ * option file parameters are:
+ *
+ *  +maxmoves=<n>  : give up after n * (# vertices) moves
+ *  +temp=<t>      : starting temperature
+ *  +cooling=<f>   : multiply temperature by f every (# vertices) moves
+ *
+ */
+int
+parse_anneal_alg_options(
+  FILE *fp,
+  char word[])
+{
+  int status;
+
+  char parmstr[STRLEN];
+  char valstr[STRLEN];
+
+  /* read next word in options file */
+  status = read_next_word(fp, word);
+
+  /* read next parameter, till read a non-parameter word, then return */
+  while ( !(status & READ_EOF) )
+  {
+    if (check_word(word) == WORD_PARM)
+    {
+      /* parse the parameter */
+      parse_parameter_str(word, parmstr, valstr);
+
+      /* maxmoves parameter */
+      if (strcasecmp(parmstr, "+maxmoves")==0)
+      {
+        g_options.anneal_alg.maxmoves = atoi(valstr);
+        if (g_options.anneal_alg.maxmoves <= 0)
+        {
+          EXIT_ERROR1("Invalid value `%s' for +maxmoves parameter.\n",valstr);
+        }
+      }
+
+      /* temp parameter */
+      else if (strcasecmp(parmstr, "+temp")==0)
+      {
+        g_options.anneal_alg.inittemp = atof(valstr);
+        if (g_options.anneal_alg.inittemp <= ANNEAL_MINTEMP)
+        {
+          EXIT_ERROR1("Invalid value `%s' for +temp parameter.\n",valstr);
+        }
+      }
+
+      /* cooling parameter */
+      else if (strcasecmp(parmstr, "+cooling")==0)
+      {
+        g_options.anneal_alg.cooling = atof(valstr);
+        if ( (g_options.anneal_alg.cooling <= 0.0) ||
+             (g_options.anneal_alg.cooling > 1.0) )
+        {
+          EXIT_ERROR1("Invalid value `%s' for +cooling parameter.\n",valstr);
+        }
+      }
+
+      else
+      {
+        WARN_ERROR1("Warning: Unidentified parameter `%s'.\n", parmstr);
+      }
+    }
+    else
+    {
+      return (status);
+    }
+
+    status = read_next_word(fp, word);
+
+  }  /* end of while loop */
+
+  return(status);
+
+}  /* end of parse_anneal_alg_options() */
+
+
+/************************************************************/
+/* this function initializes the annealing alg options
+ */
+void
+init_anneal_alg_options()
+{
+  g_options.anneal_alg.maxmoves = ANNEAL_DEF_MAXMOVES;
+  g_options.anneal_alg.inittemp = ANNEAL_DEF_TEMP;
+  g_options.anneal_alg.cooling = ANNEAL_DEF_COOLING;
+
+}  /* end of init_anneal_alg_options() */
+
+
+/************************************************************/
+/* this function prints the annealing alg options
+ */
+void
+print_anneal_alg_options(
+  FILE *fp)
+{
+  fprintf(fp, "    maximum moves (per vertex) = %d\n",
+	g_options.anneal_alg.maxmoves);
+  fprintf(fp, "    starting temperature = %.3f\n",
+	g_options.anneal_alg.inittemp);
+  fprintf(fp, "    cooling factor = %.4f\n", g_options.anneal_alg.cooling);
+
+}  /* end of print_anneal_alg_options() */
+
@@ -0,0 +1,47 @@
+
+
+
+#ifndef _ANNEAL_H_
+#define _ANNEAL_H_
+
+
+/************************************************************/
+/* defines and data structures */
+/************************************************************/
+
+/* default values for the annealing parameters */
+#define ANNEAL_DEF_MAXMOVES	1000	/* moves per vertex */
+#define ANNEAL_DEF_TEMP		1.0
+#define ANNEAL_DEF_COOLING	0.99
+
+/* temperature at which the search is reheated to the initial temperature */
+#define ANNEAL_MINTEMP		0.01
+
+/* how often (in moves) to check the time limit */
+#define ANNEAL_TIMECHECK	1024
+
+/* options structure */
+typedef struct {
+
+  int maxmoves;		/* max # of moves, as a multiple of # of vertices */
+  float inittemp;	/* starting temperature */
+  float cooling;	/* temperature multiplier, applied every numvert moves */
+
+}  anneal_alg_options_type;
+
+
+/************************************************************/
+/* function declarations */
+/************************************************************/
+
+int master_anneal_alg( graph_type *graph, stat_pertrial_type *trialstats,
+	int solution[]);
+
+int parse_anneal_alg_options( FILE *fp, char word[]);
+
+void init_anneal_alg_options();
+
+void print_anneal_alg_options( FILE *fp);
+
+#endif /* _ANNEAL_H_ */
+
@@ -0,0 +1,157 @@
+
+
+/* project includes */
+#include "main.h"
+
+
+/************************************************************/
+/* bump allocator for the scratch memory of a trial
+ *
+ * the solvers take their graph copies, edge stacks and path arrays from
+ * here instead of the stack, and the generators their temporary arrays.
+ * memory is handed out by bumping a pointer, and given back all at once:
+ * arena_reset() at the start of each trial (test_hc_alg()), or
+ * arena_release() back to an arena_mark() for scratch that is only needed
+ * inside one function.  after the first few trials the arena is a single
+ * block of the size the trials need, and no more malloc() calls are made.
+ */
+/************************************************************/
+
+arena_block_type *g_arena = NULL;	/* current (newest) block */
+
+
+/************************************************************/
+/* this function adds a new block of at least size bytes to the arena */
+void
+arena_add_block(
+  size_t size)
+{
+  arena_block_type *block;
+
+  if (size < ARENA_MINBLOCK)
+    size = ARENA_MINBLOCK;
+
+  block = (arena_block_type *) malloc(sizeof(arena_block_type) + size + 
+		ARENA_ALIGN);
+  if (block == NULL)
+  {
+    EXIT_ERROR1("Error allocating %lu bytes of scratch memory.\n", 
+	(unsigned long) size);
+  }
+
+  block->prev = g_arena;
+  block->size = size;
+  block->used = 0;
+  block->data = (char *) (((size_t) (block + 1) + ARENA_ALIGN - 1) &
+			~((size_t) ARENA_ALIGN - 1));
+  g_arena = block;
+
+}  /* end of arena_add_block() */
+
+
+/************************************************************/
+/* this function frees the newest block of the arena */
+void
+arena_free_block()
+{
+  arena_block_type *block = g_arena;
+
+  g_arena = block->prev;
+  free(block);
+
+}  /* end of arena_free_block() */
+
+
+/************************************************************/
+/* this function returns size bytes of (uninitialized) memory from the
+ * arena
+ */
+void *
+arena_alloc(
+  size_t size)
+{
+  void *mem;
+
+  size = (size + ARENA_ALIGN - 1) & ~((size_t) ARENA_ALIGN - 1);
+
+  if ( (g_arena == NULL) || (g_arena->used + size > g_arena->size) )
+    arena_add_block(size);
+
+  mem = g_arena->data + g_arena->used;
+  g_arena->used += size;
+
+  return(mem);
+
+}  /* end of arena_alloc() */
+
+
+/************************************************************/
+/* this function returns the current position of the arena */
+arena_mark_type
+arena_mark()
+{
+  arena_mark_type mark;
+
+  mark.block = g_arena;
+  mark.used = (g_arena == NULL) ? 0 : g_arena->used;
+
+  return(mark);
+
+}  /* end of arena_mark() */
+
+
+/************************************************************/
+/* this function gives back everything allocated since mark was taken.
+ * blocks added since then are freed
+ */
+void
+arena_release(
+  arena_mark_type mark)
+{
+  while (g_arena != mark.block)
+    arena_free_block();
+
+  if (g_arena != NULL)
+    g_arena->used = mark.used;
+
+}  /* end of arena_release() */
+
+
+/************************************************************/
+/* this function gives back everything in the arena.  if it has grown
+ * past one block, the blocks are replaced by one block of their total
+ * size
+ */
+void
+arena_reset()
+{
+  size_t total = 0;
+
+  if (g_arena == NULL)
+    return;
+
+  if (g_arena->prev != NULL)
+  {
+    while (g_arena != NULL)
+    {
+      total += g_arena->size;
+      arena_free_block();
+    }
+    arena_add_block(total);
+  }
+
+  g_arena->used = 0;
+
+}  /* end of arena_reset() */
+
+
+/************************************************************/
+/* this function frees all the arena memory */
+void
+arena_free()
+{
+  while (g_arena != NULL)
+    arena_free_block();
+
+}  /* end of arena_free() */
+
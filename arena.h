@@ -0,0 +1,52 @@
+
+
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+
+/************************************************************/
+/* defines and data structures */
+/************************************************************/
+
+/* allocations are aligned to cache lines */
+#define ARENA_ALIGN	64
+
+/* smallest block taken from malloc() */
+#define ARENA_MINBLOCK	(1 << 20)
+
+/* a block of arena memory.  blocks are only added when the current one
+ * is full, and are merged into one at the next arena_reset()
+ */
+typedef struct arena_block_struct {
+  struct arena_block_struct *prev;	/* previous (older) block */
+  size_t size;				/* bytes usable at data */
+  size_t used;				/* bytes handed out */
+  char *data;				/* ARENA_ALIGN aligned */
+  } arena_block_type;
+
+/* a position in the arena, see arena_mark() and arena_release() */
+typedef struct {
+  arena_block_type *block;
+  size_t used;
+  } arena_mark_type;
+
+#define ARENA_NEW(type)		((type *) arena_alloc(sizeof(type)))
+#define ARENA_ARRAY(type,n)	((type *) arena_alloc((n) * sizeof(type)))
+
+
+/************************************************************/
+/* function declarations */
+/************************************************************/
+
+void *arena_alloc( size_t size);
+
+arena_mark_type arena_mark();
+
+void arena_release( arena_mark_type mark);
+
+void arena_reset();
+
+void arena_free();
+
+#endif /* _ARENA_H_ */
+
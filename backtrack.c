@@ -4,13 +4,18 @@
 
 #include "main.h"
 
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
 
 /* local visitlist structure
  * necessary so visitlist can be sorted
  */
 typedef struct {
   int vert;
-  int deg;
+  int key;	/* degree, or the score of the +degsort method */
   }  visitlist_type;
 
 #define HIT_YES 1
@@ -18,6 +23,68 @@ typedef struct {
 
 int g_hit_nodelimit = HIT_NO;
 
+/* data for the reachability check (HC_PRUNE_REACH):  adjacency of the 
+ * search graph (taken after the initial pruning) and the set of 
+ * vertices that are not in the path
+ */
+adjmatrix_type g_reach_adj;
+vset_type g_reach_unvisited;
+
+/* failed state memo table (+memo):  whether a path can be completed 
+ * depends only on its vertex set and its two ends, so states shown to
+ * fail are saved by a (zobrist) hash of those.  each bucket has a 
+ * depth-preferred entry, kept while it has the largest saved subtree, 
+ * and an always-replace entry for the most recent failure.
+ */
+typedef struct {
+  unsigned long long key;
+  int work;		/* # of nodes used to show failure, 0 if empty */
+  }  memo_entry_type;
+
+typedef struct {
+  memo_entry_type deep;
+  memo_entry_type recent;
+  }  memo_bucket_type;
+
+typedef struct {
+  memo_bucket_type *table;	/* NULL if not memoizing */
+  unsigned long long mask;	/* # of buckets - 1 */
+  unsigned long long pathkey;	/* hash of the path vertices */
+  unsigned long long vertkey[MAXVERT];
+  unsigned long long endkey[MAXVERT];
+  unsigned long long startkey[MAXVERT];
+  int hits;
+  int misses;
+  int stores;
+  }  memo_type;
+
+memo_type g_memo;
+
+/* search tree profile (-report +tree):  # of nodes expanded at each 
+ * depth (path length), and # of subtrees cut off at each depth by each 
+ * cause (CAUSE_*)
+ */
+typedef struct {
+  int on;
+  int numvert;
+  long long nodes[MAXVERT+2];
+  long long cuts[NUM_CAUSES][MAXVERT+2];
+  }  bt_tree_type;
+
+bt_tree_type g_tree;
+
+#define BT_TREE_CUT(cause,depth) { if (g_tree.on) g_tree.cuts[cause][depth]++; }
+
+/* conflict weights (+degsort=conflict):  the # of times going to each
+ * vertex of the search graph led straight to a dead end, in this trial.
+ * vertices that often fail are tried first, so their failures come
+ * early (as the weighted degree heuristic of constraint solvers does)
+ */
+int g_conflict[MAXVERT];
+
+#define BT_CONFLICT(vert) \
+  { if (g_options.bt_alg.degsortflag == DEGSORT_CONFLICT) g_conflict[vert]++; }
+
 /************************************************************/
 /* function to check node limit for backtrack HC algorithm
  * returns HC_QUIT if hit node limit
@@ -45,69 +112,621 @@ bt_check_nodelimit(
   
 
 /************************************************************/
-/* comparison function for visitlist data structure
- * (for sorting)
- * results returned depend on the degsortflag
+/* function to set up the vertex set data kept along with the path 
+ * (for the reachability check and the memo table), for a search of 
+ * the specified graph starting at vertex initvert
+ */
+void
+bt_init_pathsets(
+  graph_type *graph,
+  int initvert)
+{
+  int loop;
+
+  if (g_options.bt_alg.pruneoptflag & HC_PRUNE_REACH)
+    calc_graph_adjmatrix(graph, &g_reach_adj);
+
+  for (loop = 0; loop < VSET_WORDS; loop++)
+    g_reach_unvisited[loop] = 0;
+  for (loop = 0; loop < graph->numvert; loop++)
+    VSET_ADD(g_reach_unvisited, loop);
+  VSET_DEL(g_reach_unvisited, initvert);
+
+  /* the start vertex is hashed by startkey[], not in the path key */
+  g_memo.pathkey = 0;
+
+}  /* end of bt_init_pathsets() */
+
+
+/************************************************************/
+/* splitmix64 generator for the memo table hash keys.  it is separate 
+ * from the lrand48() generator so that turning the memo table on 
+ * doesn't change the random choices of the search
+ */
+unsigned long long
+bt_memo_rand(
+  unsigned long long *state)
+{
+  unsigned long long z;
+
+  z = (*state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return(z ^ (z >> 31));
+
+}  /* end of bt_memo_rand() */
+
+
+/************************************************************/
+/* function to allocate the memo table (of size megabytes, rounded 
+ * down to a power of 2 number of buckets), and set the hash keys for
+ * a graph of numvert vertices.  
+ * if the table can't be allocated, the search is run without it
  */
-static int
-compare_visitlist(
-  void *vert1,
-  void *vert2)
+void
+bt_memo_init(
+  int megabytes,
+  int numvert)
 {
-  visitlist_type *v1;
-  visitlist_type *v2;
+  unsigned long long numbucket = 1;
+  unsigned long long state = 0x2545F4914F6CDD1DULL;
+  int loop;
 
-  v1 = (visitlist_type *) vert1;
-  v2 = (visitlist_type *) vert2;
+  while (2 * numbucket * sizeof(memo_bucket_type) <= 
+	 (unsigned long long) megabytes * 1024 * 1024)
+  {
+    numbucket *= 2;
+  }
 
-  if (g_options.bt_alg.degsortflag == DEGSORT_MIN)
+  g_memo.table = (memo_bucket_type *) calloc(numbucket, 
+	sizeof(memo_bucket_type));
+  if (g_memo.table == NULL)
   {
-    /* sort by increasing degree */
-    if (v1->deg < v2->deg)
-      return (-1);
-    else if (v1->deg > v2->deg)
-      return (1);
-    else
-      return (0);
+    WARN_ERROR1("Warning: cannot allocate %d MB memo table, not using it.\n",
+	megabytes);
+    return;
+  }
+  g_memo.mask = numbucket - 1;
+
+  for (loop = 0; loop < numvert; loop++)
+  {
+    g_memo.vertkey[loop]  = bt_memo_rand(&state);
+    g_memo.endkey[loop]   = bt_memo_rand(&state);
+    g_memo.startkey[loop] = bt_memo_rand(&state);
+  }
+
+  g_memo.hits = g_memo.misses = g_memo.stores = 0;
+
+}  /* end of bt_memo_init() */
+
+
+/************************************************************/
+/* function to free the memo table 
+ */
+void
+bt_memo_free()
+{
+  free(g_memo.table);
+  g_memo.table = NULL;
+
+}  /* end of bt_memo_free() */
+
+
+/************************************************************/
+/* function to look up the hash key of a search state in the memo table
+ * returns HC_NOT_EXIST if the state is known to fail
+ * returns HC_NOT_FOUND otherwise
+ */
+int
+bt_memo_lookup(
+  unsigned long long key)
+{
+  memo_bucket_type *bucket = &g_memo.table[key & g_memo.mask];
+
+  if ( ((bucket->deep.work > 0) && (bucket->deep.key == key)) ||
+       ((bucket->recent.work > 0) && (bucket->recent.key == key)) )
+  {
+    g_memo.hits++;
+    return(HC_NOT_EXIST);
+  }
+
+  g_memo.misses++;
+  return(HC_NOT_FOUND);
+
+}  /* end of bt_memo_lookup() */
+
+
+/************************************************************/
+/* function to save a failed search state in the memo table
+ * work is the number of nodes it took to show the state fails 
+ */
+void
+bt_memo_store(
+  unsigned long long key,
+  int work)
+{
+  memo_bucket_type *bucket = &g_memo.table[key & g_memo.mask];
+
+  g_memo.stores++;
+  if (work >= bucket->deep.work)
+  {
+    /* the old deep entry is not lost yet, it becomes the recent one */
+    if (bucket->deep.key != key)
+      bucket->recent = bucket->deep;
+    bucket->deep.key  = key;
+    bucket->deep.work = work;
   }
   else
-  { 
-    /* sort by decreasing degree (so largest is first) */
-    if (v1->deg > v2->deg)
-      return (-1);
-    else if (v1->deg < v2->deg)
-      return (1);
-    else
-      return (0);
+  {
+    bucket->recent.key  = key;
+    bucket->recent.work = work;
+  }
+
+}  /* end of bt_memo_store() */
+
+
+/************************************************************/
+/* reachability check for the pruning backtrack:  checks that every
+ * unvisited vertex can be reached from the end of the path through 
+ * unvisited vertices only, and that the start of the path has an
+ * unvisited neighbour to come back through.  the search frontier is
+ * kept as a vertex bit set, and expanded 64 vertices at a time.
+ *
+ * the adjacency used is that of the graph when the search started,
+ * which can only have more edges than the current graph, so the check
+ * never removes a path that could be completed.
+ *
+ * returns HC_NOT_EXIST if the path cannot be completed to a cycle,
+ * returns HC_NOT_FOUND otherwise
+ */
+int
+bt_check_reachable(
+  int startvert,
+  int endvert,
+  int numvert)
+{
+  vset_type reached;
+  vset_type frontier;
+  vset_type next;
+  unsigned long long bits;
+  unsigned long long *row;
+  unsigned long long missing = 0;
+  unsigned long long backedge = 0;
+  int numwords = (numvert + 63) / 64;
+  int grow;
+  int wloop, eloop;
+
+  /* start with the unvisited neighbours of the end vertex */
+  grow = 0;
+  row = g_reach_adj.row[endvert];
+  for (wloop = 0; wloop < numwords; wloop++)
+  {
+    frontier[wloop] = reached[wloop] = row[wloop] & g_reach_unvisited[wloop];
+    grow |= (frontier[wloop] != 0);
+  }
+
+  /* expand the frontier until nothing new is reached */
+  while (grow)
+  {
+    for (wloop = 0; wloop < numwords; wloop++)
+      next[wloop] = 0;
+
+    for (wloop = 0; wloop < numwords; wloop++)
+    {
+      bits = frontier[wloop];
+      while (bits)
+      {
+        row = g_reach_adj.row[ (wloop << 6) + __builtin_ctzll(bits) ];
+        bits &= bits - 1;
+        for (eloop = 0; eloop < numwords; eloop++)
+          next[eloop] |= row[eloop];
+      }
+    }
+
+    grow = 0;
+    for (wloop = 0; wloop < numwords; wloop++)
+    {
+      frontier[wloop] = next[wloop] & g_reach_unvisited[wloop] & 
+		~reached[wloop];
+      reached[wloop] |= frontier[wloop];
+      grow |= (frontier[wloop] != 0);
+    }
+  }
+
+  row = g_reach_adj.row[startvert];
+  for (wloop = 0; wloop < numwords; wloop++)
+  {
+    missing |= g_reach_unvisited[wloop] & ~reached[wloop];
+    backedge |= g_reach_unvisited[wloop] & row[wloop];
+  }
+
+  if ( (missing != 0) || (backedge == 0) )
+  {
+    if (g_options.report_flags & REPORT_ALG)
+    {
+      fprintf(g_options.log_fp, "Unvisited vertices cannot be reached from "
+	"the path, which implies no hamiltonian cycle.\n");
+    }
+    return(HC_NOT_EXIST);
+  }
+
+  return(HC_NOT_FOUND);
+
+}  /* end of bt_check_reachable() */
+
+
+/************************************************************/
+/* this function clears the search tree profile, at the start of a trial
+ */
+void
+bt_tree_reset(
+  int numvert)
+{
+  g_tree.on = (g_options.report_flags & REPORT_TREE) ? 1 : 0;
+  g_tree.numvert = numvert;
+
+  if (g_tree.on)
+  {
+    memset(g_tree.nodes, 0, sizeof(g_tree.nodes));
+    memset(g_tree.cuts, 0, sizeof(g_tree.cuts));
+  }
+
+}  /* end of bt_tree_reset() */
+
+
+/************************************************************/
+/* this function prints the search tree profile as a table, with the
+ * depths grouped into at most BT_TREE_ROWS rows:  nodes expanded, 
+ * branching factor (geometric mean over the depths of the row), and 
+ * subtrees cut off by each cause.  then for each cause, the average depth
+ * of its cuts and an estimate of the nodes it saved, taking a subtree cut
+ * at depth d to be as big as the average subtree at d (from the measured
+ * branching factors)
+ */
+#define BT_TREE_ROWS 16
+
+void
+bt_tree_print(
+  FILE *fp)
+{
+  static char causestr[NUM_CAUSES][10] = { "degree", "deg2nbr", "shortcyc",
+		"connect", "cutpoint", "reach", "memo" };
+
+  double est[MAXVERT+3];
+  double estcut, depthsum;
+  double branch;
+  long long rownodes, totnodes = 0;
+  long long rowcuts[NUM_CAUSES], totcuts;
+  int maxdepth = 0;
+  int width, start, end;
+  int loop, cloop;
+
+  /* find the deepest node or cut */
+  for (loop = 1; loop <= g_tree.numvert + 1; loop++)
+  {
+    totnodes += g_tree.nodes[loop];
+    if (g_tree.nodes[loop] > 0)
+      maxdepth = loop;
+    for (cloop = 0; cloop < NUM_CAUSES; cloop++)
+    {
+      if (g_tree.cuts[cloop][loop] > 0)
+        maxdepth = loop;
+    }
+  }
+
+  if (maxdepth == 0)
+    return;
+
+  /* est[d] = average size of a subtree rooted at depth d */
+  est[maxdepth+1] = 0.0;
+  for (loop = maxdepth; loop >= 1; loop--)
+  {
+    branch = (g_tree.nodes[loop] > 0) ? 
+	(double) g_tree.nodes[loop+1] / (double) g_tree.nodes[loop] : 0.0;
+    est[loop] = 1.0 + branch * est[loop+1];
+  }
+
+  fprintf(fp, "Search tree profile (depth = path length):\n");
+  fprintf(fp, "  depth          nodes  branch");
+  for (cloop = 0; cloop < NUM_CAUSES; cloop++)
+    fprintf(fp, " %9s", causestr[cloop]);
+  fprintf(fp, "\n");
+
+  width = (maxdepth + BT_TREE_ROWS - 1) / BT_TREE_ROWS;
+  for (start = 1; start <= maxdepth; start += width)
+  {
+    end = start + width - 1;
+    if (end > maxdepth)
+      end = maxdepth;
+
+    rownodes = 0;
+    for (cloop = 0; cloop < NUM_CAUSES; cloop++)
+      rowcuts[cloop] = 0;
+    for (loop = start; loop <= end; loop++)
+    {
+      rownodes += g_tree.nodes[loop];
+      for (cloop = 0; cloop < NUM_CAUSES; cloop++)
+        rowcuts[cloop] += g_tree.cuts[cloop][loop];
+    }
+
+    branch = (g_tree.nodes[start] > 0) ? 
+	pow((double) g_tree.nodes[end+1] / (double) g_tree.nodes[start],
+	    1.0 / (end + 1 - start)) : 0.0;
+
+    fprintf(fp, "  %4d-%-4d %11lld %7.3f", start, end, rownodes, branch);
+    for (cloop = 0; cloop < NUM_CAUSES; cloop++)
+      fprintf(fp, " %9lld", rowcuts[cloop]);
+    fprintf(fp, "\n");
+  }
+
+  fprintf(fp, "Effective branching factor %.3f (%lld nodes, max depth %d).\n",
+	pow((double) totnodes, 1.0 / maxdepth), totnodes, maxdepth);
+
+  fprintf(fp, "  cause         cuts  ave depth  est nodes cut\n");
+  for (cloop = 0; cloop < NUM_CAUSES; cloop++)
+  {
+    totcuts = 0;
+    depthsum = estcut = 0.0;
+    for (loop = 1; loop <= maxdepth; loop++)
+    {
+      totcuts += g_tree.cuts[cloop][loop];
+      depthsum += (double) g_tree.cuts[cloop][loop] * loop;
+      estcut += (double) g_tree.cuts[cloop][loop] * est[loop];
+    }
+
+    if (totcuts > 0)
+    {
+      fprintf(fp, "  %-9s %8lld %10.1f %14.4g\n", causestr[cloop], totcuts,
+	depthsum / totcuts, estcut);
+    }
+  }
+
+}  /* end of bt_tree_print() */
+
+
+/************************************************************/
+/* this function returns the count worker that searches the subtree of
+ * a path at the split depth, from a hash of the path.  (the order that
+ * the subtrees are reached in can't be used, it changes with the order
+ * of the neighbour lists, which the edges put back by the rollbacks of
+ * the subtrees searched before are added to the end of)
+ */
+int
+bt_count_owner(
+  path_type *path,
+  int pstart,
+  int plength)
+{
+  unsigned long long hash = 0;
+  int loop;
+  int tempnum;
+
+  for (tempnum = pstart, loop = 0; loop < plength; loop++)
+  {
+    hash = (hash ^ path[tempnum].gvert) * 0x9E3779B97F4A7C15ULL;
+    tempnum = path[tempnum].next;
+  }
+
+  return( (int) ((hash >> 32) % g_count.numworkers) );
+
+}  /* end of bt_count_owner() */
+
+
+/************************************************************/
+/* this function counts the hamiltonian path of the search as a cycle
+ * (+count), if its ends are joined.  the path can't be turned into a
+ * cycle some other way, as hc_path_to_cycle() does, or cycles would be
+ * counted more than once.  the first cycle is kept in g_count.solution,
+ * and each one is written to the solution file if listing them.
+ * returns HC_FOUND if the count has reached the cap (stop searching)
+ * returns HC_NOT_EXIST otherwise
+ */
+int
+bt_count_cycle(
+  graph_type *graph,
+  path_type *path,
+  int pstart,
+  int pend,
+  int numvert)
+{
+  int cycle[MAXVERT];
+  int loop;
+  int tempnum;
+
+  if (check_if_edge(graph, path[pend].gvert, path[pstart].gvert) 
+	!= EDGE_EXIST)
+  {
+    return(HC_NOT_EXIST);
+  }
+
+  g_count.count++;
+
+  if ( (!g_count.found) || (g_count.enumerate) )
+  {
+    for (tempnum = pstart, loop = 0; loop < numvert; loop++)
+    {
+      cycle[loop] = path[tempnum].gvert;
+      tempnum = path[tempnum].next;
+    }
+
+    if (!g_count.found)
+    {
+      memcpy(g_count.solution, cycle, numvert * sizeof(int));
+      g_count.found = 1;
+    }
+    if (g_count.enumerate)
+      count_write_cycle(cycle, numvert);
   }
 
-}  /* end of compare_visitlist() */
+  if ( (g_count.cap > 0) && (g_count.count >= g_count.cap) )
+    return(HC_FOUND);
+
+  return(HC_NOT_EXIST);
+
+}  /* end of bt_count_cycle() */
+
+
+/************************************************************/
+/* this function returns how far a count search got (COUNT_*), from the
+ * return value of calc_backtrack_alg()
+ */
+int
+bt_count_exact(
+  int ret)
+{
+  if (ret == HC_FOUND)
+    return(COUNT_CAPPED);
+  if (ret == HC_NOT_FOUND)
+    return(COUNT_PARTIAL);
+
+  return(COUNT_EXACT);
+
+}  /* end of bt_count_exact() */
+
+
+/************************************************************/
+/* sorts a visitlist into increasing key order.  this is a stable
+ * insertion sort:  visit lists are short (at most MAXDEGREE entries,
+ * usually only a few), so it beats qsort() and its comparison calls.
+ * sort_visitlist_max() is the same, for decreasing key order (kept
+ * as a separate copy so the sort order isn't tested at each compare)
+ */
+void
+sort_visitlist_min(
+  visitlist_type visitlist[], 
+  int numvisit)
+{
+  int loop, eloop;
+  visitlist_type temp;
+
+  for (loop = 1; loop < numvisit; loop++)
+  {
+    temp = visitlist[loop];
+    for (eloop = loop; (eloop > 0) && (visitlist[eloop-1].key > temp.key);
+	 eloop--)
+    {
+      visitlist[eloop] = visitlist[eloop-1];
+    }
+    visitlist[eloop] = temp;
+  }
+
+}  /* end of sort_visitlist_min() */
+
+
+/************************************************************/
+/* sorts a visitlist into decreasing key order (see 
+ * sort_visitlist_min())
+ */
+void
+sort_visitlist_max(
+  visitlist_type visitlist[], 
+  int numvisit)
+{
+  int loop, eloop;
+  visitlist_type temp;
+
+  for (loop = 1; loop < numvisit; loop++)
+  {
+    temp = visitlist[loop];
+    for (eloop = loop; (eloop > 0) && (visitlist[eloop-1].key < temp.key);
+	 eloop--)
+    {
+      visitlist[eloop] = visitlist[eloop-1];
+    }
+    visitlist[eloop] = temp;
+  }
+
+}  /* end of sort_visitlist_max() */
+
+
+/************************************************************/
+/* this function returns the score of going to vertex vert, for the 
+ * dynamic +degsort methods (lower scores are tried first):
+ *
+ *   DEGSORT_UNVISIT:  # of unvisited neighbours of vert, the choices
+ *     left once the path is at vert
+ *   DEGSORT_FORCE:  minus the # of unvisited neighbours of vert of
+ *     degree 3, which are left with degree 2 (forced) when the path
+ *     goes on from vert, so the moves that force the most come first
+ *   DEGSORT_CONFLICT:  minus the conflict weight of vert
+ *
+ * ties are broken by increasing degree
+ */
+int
+bt_visit_score(
+  graph_type *graph,
+  graphpath_type *graphpath,
+  int vert)
+{
+  nbrmask_type unvisited, forced;
+  int score = 0;
+  int loop;
+  int nbr;
+
+  switch (g_options.bt_alg.degsortflag)
+  {
+    case DEGSORT_UNVISIT:
+      hc_classify_nbrs(graph, graphpath, vert, &unvisited, &forced);
+      score = NBRMASK_COUNT(unvisited);
+      break;
+
+    case DEGSORT_FORCE:
+      for (loop = 0; loop < graph->deg[vert]; loop++)
+      {
+        nbr = graph->nbr[vert][loop];
+        if ( (graphpath->pathpos[nbr] == -1) && (graph->deg[nbr] == 3) )
+          score--;
+      }
+      break;
+
+    case DEGSORT_CONFLICT:
+      score = -g_conflict[vert];
+      break;
+  }
+
+  return(score * (MAXDEGREE + 1) + graph->deg[vert]);
+
+}  /* end of bt_visit_score() */
 
 
 /************************************************************/
 /* this function takes a list (array) of vertices and sorts
- * them according to the degsortflag (used in the comparision function)
+ * them according to the degsortflag
  *
- * note that preferably, vertices with equal degrees should be ordered
- * randomly.  qsort orders equal elements unpredictablely, which is good
- * enough
+ * vertices with equal keys are ordered randomly:  the list is
+ * shuffled first, and the sort keeps the order of equal elements
  */
 void
 sort_visitlist(
   graph_type *graph, 
+  graphpath_type *graphpath,
   visitlist_type visitlist[], 
   int numvisit)
 {
   int loop;
+  int swapindex;
+  visitlist_type temp;
 
-  /* set .deg field for visitlist array */
+  /* set .key field for visitlist array, shuffling as it is set */
   for (loop = 0; loop < numvisit; loop++)
   {
-    visitlist[loop].deg = graph->deg[visitlist[loop].vert];
+    if ( (g_options.bt_alg.degsortflag == DEGSORT_MIN) ||
+	 (g_options.bt_alg.degsortflag == DEGSORT_MAX) )
+      visitlist[loop].key = graph->deg[visitlist[loop].vert];
+    else
+      visitlist[loop].key = bt_visit_score(graph, graphpath, 
+		visitlist[loop].vert);
+
+    swapindex = (int) (lrand48() % (loop + 1));
+    temp = visitlist[loop];
+    visitlist[loop] = visitlist[swapindex];
+    visitlist[swapindex] = temp;
   }
 
-  /* call qsort() function */
-  qsort(visitlist, numvisit, sizeof(visitlist_type), (void *)compare_visitlist);
+  if (g_options.bt_alg.degsortflag == DEGSORT_MAX)
+    sort_visitlist_max(visitlist, numvisit);
+  else
+    sort_visitlist_min(visitlist, numvisit);
 
 }  /* end of sort_visitlist() */
 
@@ -142,11 +761,17 @@ calc_noprune_bt_alg(
   int newvert;
   
   (*nodecount)++;
+  PROGRESS_NODE(*plength);
 
   /* if have hamiltonian path, then try to convert into a cycle */
   if (*plength == graph->numvert) 
   {
-    return(hc_path_to_cycle(graph, path, graphpath, pstart, pend, *plength) );
+    int ret;
+
+    PHASE_START(PHASE_CLOSE);
+    ret = hc_path_to_cycle(graph, path, graphpath, pstart, pend, *plength);
+    PHASE_STOP(PHASE_CLOSE);
+    return(ret);
   }
 
   /* loop through neighbours of current endpoint, trying each in turn */
@@ -155,7 +780,7 @@ calc_noprune_bt_alg(
     /* if neigbhour is not in path, then add to path and recurse */
     newvert = graph->nbr[path[*pend].gvert][loop];
 
-    if (graphpath[newvert].pathpos == -1)
+    if (graphpath->pathpos[newvert] == -1)
     {
       /* add current neighbour to path and recurse */
       oldpend = *pend;
@@ -209,7 +834,7 @@ calc_backtrack_alg(
   edgestack_type *edgestack)
 {
   int loop, vloop;
-  int oldpend;
+  int oldend;
   int newvert;
 
   int ret;
@@ -220,12 +845,37 @@ calc_backtrack_alg(
 
   int numforced;
   int forcedvert = 0;
+  int curvert;
+  nbrmask_type unvisited, forced;
+
+  int atstart = 0;	/* 1 if the start of the path is extended (+bidir) */
+  int startvert;
+  int numsforced;
+  nbrmask_type sunvisited, sforced;
 
   int localstackpnt;
 
+  unsigned long long memokey = 0;
+  int startnodes = *nodecount;
+  int childnodes;
+  int childhits;
+  long long childcount;
+  long long startcount = g_count.count;
+  long long startskipped = g_count.skipped;
+
   if (g_hit_nodelimit == HIT_YES)
     return(HC_NOT_FOUND);
 
+  /* count workers only search their share of the subtrees at the split
+   * depth
+   */
+  if ( (g_count.numworkers > 1) && (*plength == g_count.splitdepth) &&
+       (bt_count_owner(path, *pstart, *plength) != g_count.worker) )
+  {
+    g_count.skipped++;
+    return(HC_NOT_EXIST);
+  }
+
   /* increment node counter, check if reached limit */
   (*nodecount)++;
   if (bt_check_nodelimit(*nodecount) == HC_QUIT)
@@ -234,33 +884,107 @@ calc_backtrack_alg(
     return(HC_NOT_FOUND);
   }
 
-  /* if have hamiltonian path, then try to convert into a cycle */
-  if (*plength == graph->numvert) 
+  PROGRESS_NODE(*plength);
+
+  if (g_tree.on)
+    g_tree.nodes[*plength]++;
+
+  /* if have hamiltonian path, then try to convert into a cycle */
+  if (*plength == graph->numvert) 
+  {
+    PHASE_START(PHASE_CLOSE);
+    if (g_count.on)
+      ret = bt_count_cycle(graph, path, *pstart, *pend, *plength);
+    else
+      ret = hc_path_to_cycle(orggraph, path, graphpath, pstart, pend, 
+		*plength);
+    PHASE_STOP(PHASE_CLOSE);
+    return(ret);
+  }
+
+  /* check if the state (path vertices and ends) is known to fail.  the
+   * start end is hashed separately, since +bidir moves it too
+   */
+  if ( (g_memo.table != NULL) && (*plength > 1) )
+  {
+    memokey = g_memo.pathkey ^ g_memo.startkey[path[*pstart].gvert] ^
+		g_memo.endkey[path[*pend].gvert];
+    if (bt_memo_lookup(memokey) == HC_NOT_EXIST)
+    {
+      BT_TREE_CUT(CAUSE_MEMO, *plength);
+      return(HC_NOT_EXIST);
+    }
+  }
+
+  /* check that the rest of the graph can still be reached */
+  if ( (g_options.bt_alg.pruneoptflag & HC_PRUNE_REACH) && (*plength > 1) )
   {
-    return(hc_path_to_cycle(orggraph, path, graphpath, pstart, pend, *plength));
+    PHASE_START(PHASE_CHECK);
+    ret = bt_check_reachable(path[*pstart].gvert, path[*pend].gvert,
+		graph->numvert);
+    PHASE_STOP(PHASE_CHECK);
+    if (ret == HC_NOT_EXIST)
+    {
+      BT_TREE_CUT(CAUSE_REACH, *plength);
+      return(HC_NOT_EXIST);
+    }
   }
 
   /* construct a prioritized visit list */
   numvisit = 0;
 
   /* count number of unvisited neighbors (of current endpoint) of degree 2 */
-  for (numforced = 0, loop = 0; loop < graph->deg[path[*pend].gvert]; loop++)
-  {
-    newvert = graph->nbr[path[*pend].gvert][loop];
-    if ( (graph->deg[newvert] == 2) && (graphpath[newvert].pathpos == -1) )
-    {
-      numforced++;
-      forcedvert = newvert;
-    }
-  }
+  curvert = path[*pend].gvert;
+  hc_classify_nbrs(graph, graphpath, curvert, &unvisited, &forced);
+  numforced = NBRMASK_COUNT(forced);
+  if (numforced > 0)
+    forcedvert = graph->nbr[curvert][NBRMASK_LAST(forced)];
 
   /* if more than 1 forced edge (and not first vertex in path), 
    * then no HC possible 
    */
   if ( (numforced == 2) && (*plength != 1) )
   {
+    BT_TREE_CUT(CAUSE_DEG2NBR, *plength);
     return(HC_NOT_EXIST);
   }
+
+  /* bidirectional search:  the start of the path is extended instead
+   * if it has fewer choices (a forced edge is 1 choice), so that the
+   * search branches where it is most constrained
+   */
+  if ( (g_options.bt_alg.bidirflag == BIDIR_ON) && (*plength > 1) )
+  {
+    startvert = path[*pstart].gvert;
+    hc_classify_nbrs(graph, graphpath, startvert, &sunvisited, &sforced);
+    numsforced = NBRMASK_COUNT(sforced);
+
+    if (numsforced >= 2)
+    {
+      BT_TREE_CUT(CAUSE_DEG2NBR, *plength);
+      return(HC_NOT_EXIST);
+    }
+
+    /* a degree 2 vertex forced at both ends would close a short cycle */
+    if ( (numforced == 1) && (numsforced == 1) &&
+	 (*plength < graph->numvert - 1) &&
+	 (forcedvert == graph->nbr[startvert][NBRMASK_LAST(sforced)]) )
+    {
+      BT_TREE_CUT(CAUSE_DEG2NBR, *plength);
+      return(HC_NOT_EXIST);
+    }
+
+    if ( ((numsforced == 1) ? 1 : NBRMASK_COUNT(sunvisited)) <
+	 ((numforced == 1) ? 1 : NBRMASK_COUNT(unvisited)) )
+    {
+      atstart = 1;
+      curvert = startvert;
+      unvisited = sunvisited;
+      numforced = numsforced;
+      if (numforced > 0)
+        forcedvert = graph->nbr[curvert][NBRMASK_LAST(sforced)];
+    }
+  }
     
   /* if 1 forced edge, then must take it */
   if (numforced == 1)
@@ -270,19 +994,16 @@ calc_backtrack_alg(
   else
   {
     /* load unvisited neighbors into visit list */
-    for (loop = 0; loop < graph->deg[path[*pend].gvert]; loop++)
+    for ( ; unvisited != 0; unvisited &= unvisited - 1)
     {
-      newvert = graph->nbr[path[*pend].gvert][loop];
-      if (graphpath[newvert].pathpos == -1)
-      {
-        visitlist[numvisit++].vert = newvert;
-      }
+      visitlist[numvisit++].vert = 
+		graph->nbr[curvert][NBRMASK_FIRST(unvisited)];
     }
     
     if (g_options.bt_alg.degsortflag != DEGSORT_RAND)
     {
-      /* order unvisited neighbors by degree */
-      sort_visitlist(graph, visitlist, numvisit);
+      /* order unvisited neighbors by degree (or score) */
+      sort_visitlist(graph, graphpath, visitlist, numvisit);
     }
 
     /* if first vertex, then can skip last edge of visitlist, since
@@ -296,29 +1017,41 @@ calc_backtrack_alg(
   /* loop through visit list, trying each in turn */
   for (vloop = 0; vloop < numvisit; vloop++)
   {
-    /* add vertex to path */
-    oldpend = *pend;
-    add_vert_to_path(path, graphpath, pstart, pend, plength, 
-      visitlist[vloop].vert);
+    /* add vertex to path (at the end being extended) */
+    if (atstart)
+    {
+      oldend = *pstart;
+      add_startvert_to_path(path, graphpath, pstart, pend, plength, 
+	visitlist[vloop].vert);
+    }
+    else
+    {
+      oldend = *pend;
+      add_vert_to_path(path, graphpath, pstart, pend, plength, 
+	visitlist[vloop].vert);
+    }
+    VSET_DEL(g_reach_unvisited, visitlist[vloop].vert);
+    g_memo.pathkey ^= g_memo.vertkey[visitlist[vloop].vert];
 
     /* save current position in edgestack */
     localstackpnt = get_curpnt_edgestack(edgestack);
 
     /* remove other edges from old end vertex to unvisited vertices 
-     * don't do this to initial vertex (need edges to return)
+     * don't do this to initial vertex while it is the other end of the
+     * path (need edges to return)
      */
     numprune = 0;
     if (*plength > 2)
     {
       loop = 0;
-      while (loop < graph->deg[path[oldpend].gvert])
+      while (loop < graph->deg[path[oldend].gvert])
       {
-        newvert = graph->nbr[path[oldpend].gvert][loop];
-        if (graphpath[newvert].pathpos == -1)  /* neighbour not in path */
+        newvert = graph->nbr[path[oldend].gvert][loop];
+        if (graphpath->pathpos[newvert] == -1)  /* neighbour not in path */
         {
-          rm_edge_graph(graph, path[oldpend].gvert, newvert);
+          rm_edge_graph(graph, path[oldend].gvert, newvert);
           numprune++;
-          push_edge_to_stack(path[oldpend].gvert, newvert, edgestack);
+          push_edge_to_stack(path[oldend].gvert, newvert, edgestack);
           /* don't increment loop variable since edge was deleted */
         }
         else 
@@ -331,9 +1064,17 @@ calc_backtrack_alg(
     if (numprune > 0)
     {
       *prune += numprune;
+      PHASE_START(PHASE_PRUNE);
       ret = hc_do_pruning(graph, &numprune, g_options.bt_alg.pruneoptflag,
 		edgestack);
+      PHASE_STOP(PHASE_PRUNE);
       *prune += numprune;
+
+      if (ret == HC_NOT_EXIST)
+      {
+        BT_TREE_CUT(hc_prune_cause(), *plength);
+        BT_CONFLICT(visitlist[vloop].vert);
+      }
     }
     else
       ret = HC_NOT_FOUND;
@@ -341,13 +1082,24 @@ calc_backtrack_alg(
     /* recursively look for HC, if HC still possible */
     if (ret != HC_NOT_EXIST) 
     {
-      if (calc_backtrack_alg(orggraph, graph, pstart, pend, plength, 
-	    path, graphpath, nodecount, prune, edgestack) == HC_FOUND)
+      childnodes = *nodecount;
+      childhits = g_memo.hits;
+      childcount = g_count.count;
+      ret = calc_backtrack_alg(orggraph, graph, pstart, pend, plength, 
+	    path, graphpath, nodecount, prune, edgestack);
+      if (ret == HC_FOUND)
       {
         return(HC_FOUND);
       }
       if (g_hit_nodelimit == HIT_YES)
         return(HC_NOT_FOUND);
+
+      /* a dead end:  the new vertex had no way on (not a leaf that
+       * counted a cycle, or a state found in the memo table)
+       */
+      if ( (ret == HC_NOT_EXIST) && (*nodecount == childnodes + 1) &&
+	   (g_count.count == childcount) && (g_memo.hits == childhits) )
+        BT_CONFLICT(visitlist[vloop].vert);
     }
 
     /* check if exceeded allowed time */
@@ -357,21 +1109,32 @@ calc_backtrack_alg(
     }
 
     /* undelete pruned edges */
-    while (get_curpnt_edgestack(edgestack) != localstackpnt)
-    {
-      int v1, v2;
-      pop_edge_from_stack(&v1, &v2, edgestack);
-
-      add_edge_graph(graph, v1, v2);
-    }
+    rollback_edgestack(graph, edgestack, localstackpnt);
 
     /* current try was bad, so backup (remove vertex from path) */
-    remove_endvert_from_path(path, graphpath, pstart, pend, plength, oldpend);
+    if (atstart)
+      remove_startvert_from_path(path, graphpath, pstart, pend, plength);
+    else
+      remove_endvert_from_path(path, graphpath, pstart, pend, plength, 
+	oldend);
+    VSET_ADD(g_reach_unvisited, visitlist[vloop].vert);
+    g_memo.pathkey ^= g_memo.vertkey[visitlist[vloop].vert];
 
     /* we don't remove the edge we just tried to traverse because it will
      * be deleted anyways when we select the next edge
      */
 
+    /* except when counting:  all the cycles through this first edge have
+     * been counted, so it is taken out to not count them again the other
+     * way around
+     */
+    if ( (g_count.on) && (*plength == 1) )
+    {
+      rm_edge_graph(graph, path[*pstart].gvert, visitlist[vloop].vert);
+      push_edge_to_stack(path[*pstart].gvert, visitlist[vloop].vert, 
+		edgestack);
+    }
+
   }  /* end of loop through visit list */
 
   /* check if exceeded allowed time */
@@ -379,11 +1142,221 @@ calc_backtrack_alg(
   {
     return(HC_NOT_FOUND);
   }
+
+  /* whole subtree was searched (no limit hit), so remember the failure
+   * (if no cycles were counted in it, or left to other count workers)
+   */
+  if ( (g_memo.table != NULL) && (*plength > 1) &&
+       (g_count.count == startcount) && (g_count.skipped == startskipped) )
+  {
+    bt_memo_store(memokey, *nodecount - startnodes);
+  }
+
   return (HC_NOT_EXIST);
 
 }  /* end of calc_backtrack_alg() */
 
 
+/************************************************************/
+/* this function runs the count search in g_count.numworkers forked
+ * worker processes, each searching every numworkers'th subtree at the
+ * split depth, and adds up their counts (and nodes and pruned edges,
+ * in trialstats).  the other parameters are as for calc_backtrack_alg(),
+ * set up for the search from the start vertex
+ */
+void
+bt_count_workers(
+  graph_type *orggraph,
+  graph_type *graph,
+  int *pstart,
+  int *pend,
+  int *plength,
+  path_type *path,
+  graphpath_type *graphpath,
+  stat_pertrial_type *trialstats,
+  edgestack_type *edgestack)
+{
+  int readfd[MAXCOUNTWORKERS];
+  pid_t pid[MAXCOUNTWORKERS];
+  int fd[2];
+  int nodecount, prune;
+  int loop, wloop;
+  int ret;
+  float used;
+
+  /* the workers must not write out our buffered output again */
+  fflush(NULL);
+  used = hc_get_elapsed_time();
+
+  for (loop = 0; loop < g_count.numworkers; loop++)
+  {
+    if (pipe(fd) != 0)
+    {
+      EXIT_ERROR1("Error creating count worker pipe (%s).\n", strerror(errno));
+    }
+
+    pid[loop] = fork();
+    if (pid[loop] < 0)
+    {
+      EXIT_ERROR1("Error starting count worker (%s).\n", strerror(errno));
+    }
+
+    if (pid[loop] == 0)
+    {
+      /* the worker only keeps the write end of its own pipe, and leaves
+       * the log and solution files to the main process
+       */
+      close(fd[0]);
+      for (wloop = 0; wloop < loop; wloop++)
+        close(readfd[wloop]);
+      g_options.report_flags = REPORT_NONE;
+      g_tree.on = 0;
+      hc_fork_timer(used);
+
+      g_count.worker = loop;
+      nodecount = prune = 0;
+      ret = calc_backtrack_alg(orggraph, graph, pstart, pend, plength, 
+		path, graphpath, &nodecount, &prune, edgestack);
+      g_count.exact = bt_count_exact(ret);
+      trialstats->nodes = nodecount;
+      trialstats->edgeprune = prune;
+
+      if (count_write_result(fd[1], trialstats, graph->numvert) != RET_OK)
+        _exit(1);
+      close(fd[1]);
+      _exit(0);
+    }
+
+    close(fd[1]);
+    readfd[loop] = fd[0];
+  }
+
+  g_count.exact = COUNT_EXACT;
+  for (loop = 0; loop < g_count.numworkers; loop++)
+  {
+    if (count_read_result(readfd[loop], trialstats, graph->numvert) 
+	!= RET_OK)
+    {
+      WARN_ERROR1("Warning: count worker %d failed, count is incomplete.\n",
+	loop+1);
+      g_count.exact = COUNT_PARTIAL;
+    }
+    close(readfd[loop]);
+    waitpid(pid[loop], NULL, 0);
+  }
+
+  /* the cap is per worker */
+  if ( (g_count.cap > 0) && (g_count.count >= g_count.cap) )
+  {
+    g_count.count = g_count.cap;
+    g_count.exact = COUNT_CAPPED;
+  }
+
+  /* there is no node limit when counting, so the workers stopped at the
+   * time limit
+   */
+  if (g_count.exact == COUNT_PARTIAL)
+    hc_set_timelimit_hit();
+
+}  /* end of bt_count_workers() */
+
+
+/************************************************************/
+/* this function counts the hamiltonian cycles of the search graph
+ * (+count), with the path set up at the start vertex:  by inclusion-
+ * exclusion if the graph is small enough (and the cycles aren't listed
+ * or capped), else by the search, split between worker processes if
+ * +countworkers is set.  the nodes and pruned edges are set in
+ * trialstats.
+ *
+ * returns HC_FOUND if a cycle was found (the first one is in 
+ *   g_count.solution), HC_NOT_EXIST if there are none, and HC_NOT_FOUND
+ *   if the time limit was reached before finding one
+ */
+int
+bt_count_alg(
+  graph_type *orggraph,
+  graph_type *graph,
+  int *pstart,
+  int *pend,
+  int *plength,
+  path_type *path,
+  graphpath_type *graphpath,
+  stat_pertrial_type *trialstats,
+  edgestack_type *edgestack)
+{
+  struct timeval start, end;
+  long long iecount;
+  int nodecount = 0;
+  int prune = 0;
+  int ret;
+
+  gettimeofday(&start, NULL);
+
+  g_count.splitdepth = graph->numvert / 2;
+  if (g_count.splitdepth > COUNT_SPLITDEPTH)
+    g_count.splitdepth = COUNT_SPLITDEPTH;
+  if (g_count.splitdepth < 2)
+    g_count.numworkers = 1;
+
+  if ( (g_count.cap == 0) && (!g_count.enumerate) && 
+       (graph->numvert >= 3) && 
+       (graph->numvert <= g_options.bt_alg.count_iemax) )
+  {
+    g_count.method = COUNT_BY_IE;
+    g_count.numworkers = 1;
+
+    PHASE_START(PHASE_SEARCH);
+    iecount = count_ie_cycles(graph);
+
+    /* the search still finds one of the cycles, for the solution */
+    if (iecount > 0)
+    {
+      g_count.cap = 1;
+      calc_backtrack_alg(orggraph, graph, pstart, pend, plength, path, 
+		graphpath, &nodecount, &prune, edgestack);
+      g_count.cap = 0;
+    }
+    PHASE_STOP(PHASE_SEARCH);
+
+    g_count.count = iecount;
+    g_count.exact = COUNT_EXACT;
+    trialstats->nodes = nodecount;
+    trialstats->edgeprune = prune;
+  }
+  else if (g_count.numworkers > 1)
+  {
+    PHASE_START(PHASE_SEARCH);
+    bt_count_workers(orggraph, graph, pstart, pend, plength, path, 
+		graphpath, trialstats, edgestack);
+    PHASE_STOP(PHASE_SEARCH);
+  }
+  else
+  {
+    PHASE_START(PHASE_SEARCH);
+    ret = calc_backtrack_alg(orggraph, graph, pstart, pend, plength, path, 
+		graphpath, &nodecount, &prune, edgestack);
+    PHASE_STOP(PHASE_SEARCH);
+
+    g_count.exact = bt_count_exact(ret);
+    trialstats->nodes = nodecount;
+    trialstats->edgeprune = prune;
+  }
+
+  gettimeofday(&end, NULL);
+  g_count.walltime = (end.tv_sec - start.tv_sec) + 
+		(end.tv_usec - start.tv_usec) / 1000000.0;
+
+  if (g_count.found)
+    return(HC_FOUND);
+  if ( (g_count.count == 0) && (g_count.exact == COUNT_EXACT) )
+    return(HC_NOT_EXIST);
+
+  return(HC_NOT_FOUND);
+
+}  /* end of bt_count_alg() */
+
+
 /************************************************************/
 /* Hamilitonian Cycle Backtrack Algorithm Wrapper Function
  *   does initial degree checking/component checking using pruning
@@ -405,37 +1378,50 @@ master_backtrack_alg(
   int loop;
   int nodecount = 0;
   int prune = 0;
-  graph_type testgraph;
+  /* the scratch structures come from the trial's arena */
+  graph_type *testgraph = ARENA_NEW(graph_type);
+
+  /* graph to use for closing the path into a cycle:  the passed in
+   * graph, or the (unmodified) reduced graph if chains are contracted 
+   * or the vertices relabelled
+   */
+  graph_type *orggraph = graph;
+  graph_type *redgraph = ARENA_NEW(graph_type);
+  hc_reduce_type *reduce = ARENA_NEW(hc_reduce_type);
+  int reduced = 0;	/* 1 if the solution must be mapped back (reduce) */
 
-  edgestack_type edgestack;   /* for saving deleted edges */
+  /* for saving deleted edges */
+  edgestack_type *edgestack = ARENA_NEW(edgestack_type);
 
-  path_type path[MAXVERT];
-  graphpath_type graphpath[MAXVERT];
+  path_type *path = ARENA_ARRAY(path_type, graph->numvert);
+  graphpath_type *graphpath = ARENA_NEW(graphpath_type);
   int pstart, pend, plength;
   int initvert;
   int tempnum;
 
-  /* initialize variables */
-  for (loop = 0; loop < graph->numvert; loop++)
-  {
-    graphpath[loop].pathpos = -1;
-    path[loop].gvert = -1;
-    path[loop].next = -1;
-  }
-
-  init_edgestack(&edgestack);
-
-  initvert = select_initvertex(graph, g_options.bt_alg.initvertflag);
-
-  pstart = pend = 0;
-  plength = 1;
-  path[pstart].gvert = initvert;
-  path[pstart].next = -1;
-  graphpath[initvert].pathpos = pstart;
+  init_edgestack(edgestack);
 
   /* update statistics */
   trialstats->nodes = 0;
   trialstats->edgeprune = 0;
+  trialstats->hccount = -1;
+
+  /* cycle counting (+count) */
+  g_count.on = ( (g_options.algorithm == ALG_BACKTRACK) &&
+		 (g_options.bt_alg.countflag == COUNT_ON) );
+  g_count.numworkers = 1;
+  if (g_count.on)
+  {
+    g_count.cap = g_options.bt_alg.count_cap;
+    g_count.count = 0;
+    g_count.exact = COUNT_EXACT;
+    g_count.method = COUNT_BY_SEARCH;
+    g_count.enumerate = (g_options.report_flags & REPORT_SOLUTION) ? 1 : 0;
+    g_count.worker = 0;
+    g_count.numworkers = g_options.bt_alg.count_workers;
+    g_count.skipped = 0;
+    g_count.found = 0;
+  }
 
   if (g_options.algorithm == ALG_BACKTRACK)
   {
@@ -445,16 +1431,26 @@ master_backtrack_alg(
   /* copy passed in graph to second graph data structure 
    * so that original graph isn't overwritten when pruning, etc.
    */
-  copy_graph(graph, &testgraph);
+  PHASE_START(PHASE_COPY);
+  copy_graph(graph, testgraph);
+  PHASE_STOP(PHASE_COPY);
 
   /* do initial pruning */
-  ret = hc_do_pruning(&testgraph, &prune, HC_PRUNE_ALL, &edgestack);
+  PHASE_START(PHASE_INITPRUNE);
+  ret = hc_do_pruning(testgraph, &prune, HC_PRUNE_ALL, edgestack);
+  PHASE_STOP(PHASE_INITPRUNE);
 
   /* update initial prune statistic */
   trialstats->initprune = prune;
 
   if (ret == HC_NOT_EXIST)
   {
+    if (g_count.on)
+    {
+      trialstats->hccount = 0;
+      trialstats->countexact = COUNT_EXACT;
+      g_count.walltime = 0.0;
+    }
     return(HC_NOT_EXIST);
   }
   /* if have forced HC, then just let backtrack quickly find it to get
@@ -462,19 +1458,106 @@ master_backtrack_alg(
    */
   prune = 0;
 
+  /* contract forced chains, and search the reduced graph instead
+   * (the initial pruning edges are not needed on the edgestack, they
+   * are never undone)
+   */
+  if (g_options.bt_alg.contractflag == CONTRACT)
+  {
+    PHASE_START(PHASE_INITPRUNE);
+    hc_contract_chains(testgraph, redgraph, reduce);
+    PHASE_STOP(PHASE_INITPRUNE);
+    PHASE_START(PHASE_COPY);
+    copy_graph(redgraph, testgraph);
+    PHASE_STOP(PHASE_COPY);
+    init_edgestack(edgestack);
+    orggraph = redgraph;
+    reduced = 1;
+
+    if (g_options.report_flags & REPORT_ALG)
+    {
+      fprintf(g_options.log_fp, "Contracted %d forced chains, "
+	"searching %d of %d vertices.\n", reduce->numchains, reduce->numred,
+	reduce->numvert);
+    }
+  }
+
+  /* relabel the vertices for locality (on top of any contraction) */
+  if (g_options.bt_alg.relabelflag != RELABEL_NONE)
+  {
+    if (!reduced)
+      hc_init_reduce(reduce, testgraph->numvert);
+
+    PHASE_START(PHASE_INITPRUNE);
+    hc_relabel_graph(testgraph, redgraph, reduce, 
+	g_options.bt_alg.relabelflag);
+    PHASE_STOP(PHASE_INITPRUNE);
+    PHASE_START(PHASE_COPY);
+    copy_graph(redgraph, testgraph);
+    PHASE_STOP(PHASE_COPY);
+    init_edgestack(edgestack);
+    orggraph = redgraph;
+    reduced = 1;
+  }
+
+  /* initialize variables */
+  for (loop = 0; loop < testgraph->numvert; loop++)
+  {
+    graphpath->pathpos[loop] = -1;
+    path[loop].gvert = -1;
+    path[loop].next = -1;
+  }
+
+  initvert = select_initvertex(orggraph, g_options.bt_alg.initvertflag);
+
+  pstart = pend = 0;
+  plength = 1;
+  path[pstart].gvert = initvert;
+  path[pstart].next = -1;
+  graphpath->pathpos[initvert] = pstart;
+  bt_init_pathsets(testgraph, initvert);
+
+  if ( (g_options.algorithm == ALG_BACKTRACK) && 
+       (g_options.bt_alg.memo_mb > 0) )
+  {
+    bt_memo_init(g_options.bt_alg.memo_mb, testgraph->numvert);
+  }
+
+  bt_tree_reset(testgraph->numvert);
+
+  if (g_options.bt_alg.degsortflag == DEGSORT_CONFLICT)
+    memset(g_conflict, 0, testgraph->numvert * sizeof(int));
+
+  g_count.reduce = (reduced) ? reduce : NULL;
+
   /* call recursive hc-backtrack algorithm */
-  if (g_options.algorithm == ALG_NOPRUNE_BT)
+  if (g_count.on)
+  {
+    ret = bt_count_alg(orggraph, testgraph, &pstart, &pend, &plength, path,
+		graphpath, trialstats, edgestack);
+
+    trialstats->hccount = g_count.count;
+    trialstats->countexact = g_count.exact;
+  }
+  else if (g_options.algorithm == ALG_NOPRUNE_BT)
   {  
-    ret = calc_noprune_bt_alg(&testgraph, &pstart, &pend, &plength, path, 
+    PHASE_START(PHASE_SEARCH);
+    ret = calc_noprune_bt_alg(testgraph, &pstart, &pend, &plength, path, 
 		graphpath, &nodecount);
+    PHASE_STOP(PHASE_SEARCH);
 
     trialstats->nodes = nodecount;
   }
   else if ( (g_options.algorithm == ALG_BACKTRACK) &&
 	    (g_options.bt_alg.restart_increment == 0) )
   {
-    ret = calc_backtrack_alg(graph, &testgraph, &pstart, &pend, &plength, 
-      path, graphpath, &nodecount, &prune, &edgestack);
+    /* max_nodes may be set for a bounded search (+ensureham=fast) */
+    g_hit_nodelimit = HIT_NO;
+
+    PHASE_START(PHASE_SEARCH);
+    ret = calc_backtrack_alg(orggraph, testgraph, &pstart, &pend, &plength, 
+      path, graphpath, &nodecount, &prune, edgestack);
+    PHASE_STOP(PHASE_SEARCH);
 
     trialstats->edgeprune = prune;
     trialstats->nodes     = nodecount;
@@ -483,13 +1566,20 @@ master_backtrack_alg(
   { /* pruning backtrack with iterated restart */
     int totnodes = 0;
     int totprune = 0;
-    graph_type usegraph;
-    edgestack_type prunestack;
+    graph_type *usegraph = ARENA_NEW(graph_type);
+    int checkpoint;
 
-    copy_edgestack(&edgestack, &prunestack);
+    /* each restart searches usegraph, and then rolls it back to the
+     * state after the initial pruning by undoing the edge deletions
+     * recorded on the edgestack since the checkpoint
+     */
+    PHASE_START(PHASE_COPY);
+    copy_graph(testgraph, usegraph);
+    PHASE_STOP(PHASE_COPY);
+    checkpoint = get_curpnt_edgestack(edgestack);
 
     g_options.bt_alg.max_nodes = g_options.bt_alg.restart_increment *
-				graph->numvert;
+				testgraph->numvert;
 
     /* this loop won't terminate until a solution is found
        use timelimit option to terminate earlier
@@ -501,28 +1591,33 @@ master_backtrack_alg(
        */
       prune = 0;
       nodecount = 0;
-      copy_graph(&testgraph, &usegraph);
-      copy_edgestack(&prunestack, &edgestack);
+      PHASE_START(PHASE_COPY);
+      rollback_edgestack(usegraph, edgestack, checkpoint);
+      PHASE_STOP(PHASE_COPY);
 
-      for (loop = 0; loop < graph->numvert; loop++)
+      for (loop = 0; loop < testgraph->numvert; loop++)
       {
-        graphpath[loop].pathpos = -1;
+        graphpath->pathpos[loop] = -1;
         path[loop].gvert = -1;
         path[loop].next = -1;
       }
   
-      initvert = select_initvertex(&usegraph, g_options.bt_alg.initvertflag);
+      initvert = select_initvertex(usegraph, g_options.bt_alg.initvertflag);
 
       pstart = pend = 0;
       plength = 1;
       path[pstart].gvert = initvert;
       path[pstart].next = -1;
-      graphpath[initvert].pathpos = pstart;
+      graphpath->pathpos[initvert] = pstart;
+      bt_init_pathsets(usegraph, initvert);
 
       g_hit_nodelimit = HIT_NO;
+      PROGRESS_STORE(restart, PROGRESS_LOAD(restart) + 1);
 
-      ret = calc_backtrack_alg(graph, &usegraph, &pstart, &pend, &plength,
-        path, graphpath, &nodecount, &prune, &edgestack);
+      PHASE_START(PHASE_SEARCH);
+      ret = calc_backtrack_alg(orggraph, usegraph, &pstart, &pend, &plength,
+        path, graphpath, &nodecount, &prune, edgestack);
+      PHASE_STOP(PHASE_SEARCH);
 
       totprune += prune;
       totnodes += nodecount;      
@@ -545,14 +1640,38 @@ master_backtrack_alg(
 
   }  /* end of pruning backtrack with iterated restart */
 
+  if (g_memo.table != NULL)
+  {
+    if (g_options.report_flags & REPORT_ALG)
+    {
+      fprintf(g_options.log_fp, "Memo table: %d hits, %d misses, "
+	"%d failed states stored.\n", g_memo.hits, g_memo.misses, 
+	g_memo.stores);
+    }
+    bt_memo_free();
+  }
+
+  if ( (g_tree.on) && (g_options.report_flags & REPORT_ALG) )
+    bt_tree_print(g_options.log_fp);
+
   if (ret == HC_FOUND)
   {
     /* convert path to solution */
-    for (tempnum = pstart, loop = 0; loop < graph->numvert; loop++)
+    if (g_count.on)
     {
-      solution[loop] = path[tempnum].gvert;
-      tempnum = path[tempnum].next;
+      memcpy(solution, g_count.solution, testgraph->numvert * sizeof(int));
     }
+    else
+    {
+      for (tempnum = pstart, loop = 0; loop < testgraph->numvert; loop++)
+      {
+        solution[loop] = path[tempnum].gvert;
+        tempnum = path[tempnum].next;
+      }
+    }
+
+    if (reduced)
+      hc_expand_solution(reduce, solution);
   }
 
   return(ret);
@@ -585,12 +1704,21 @@ master_backtrack_alg(
  *       maxdeg : maximum degree vertex is selected
  *       randeg : probability of selection proportional to degree
  *       first  : first vertex in graph is selected
+ *  +contract : contract forced chains after the initial pruning, and
+ *              search the reduced graph
+ *  +relabel = <see below> : relabel the vertices after the initial pruning
+ *       none : keep the labels (default)
+ *       bfs  : breadth first search order
+ *       rcm  : reverse cuthill-mckee order
  *
  *  Pruning backtrack parameters:
  *  +degsort = <see below> : sort visit list by degree, specifying sort order
  *       rand = random order (default) (uses order in graph, not really random)
  *       min  = min degree first, increasing order
  *       max  = max degree first, decreasing order
+ *       unvisited = fewest unvisited neighbours first
+ *       forcing   = most neighbours left forced (degree 2) first
+ *       conflict  = most failures (dead ends) so far first
  *  +pruneopt = <see below> : specify level of pruning to do (hc_do_pruning)
  *       each character adds another type of pruning to be done
  *       'N' = no pruning done (default)
@@ -598,7 +1726,13 @@ master_backtrack_alg(
  *       'C' = cycle (forced path) pruning
  *       'O' = connect components pruning (checking)
  *       'A' = articulation (cut) point checking
+ *       'R' = reachability (from path end) checking
  *  +restart = <N> : specify iterated restart mode & increment size
+ *  +memo = <MB> : size of memo table of failed search states (0 = none)
+ *  +bidir : extend the path at whichever end has fewer choices
+ *  +count [= <cap>] : count the hamiltonian cycles (up to cap of them)
+ *  +countworkers = <N> : # of worker processes to count with
+ *  +countie = <N> : count graphs of up to N vertices by inclusion-exclusion
  *
  *  Other Possible Pruning backtrack options not implemented (yet)
  *  +forcecheck : check and follow forced edges
@@ -654,6 +1788,33 @@ parse_backtrack_alg_options(
         }
       }
 
+      /* contractflag parameter */
+      else if (strcasecmp(parmstr, "+contract")==0) 
+      {
+        g_options.bt_alg.contractflag = CONTRACT;
+      }
+
+      /* relabelflag parameter */
+      else if (strcasecmp(parmstr, "+relabel")==0) 
+      {
+        if (strcasecmp(valstr, "none")==0)
+        {
+          g_options.bt_alg.relabelflag = RELABEL_NONE;
+        }
+        else if (strcasecmp(valstr, "bfs")==0)
+        {
+          g_options.bt_alg.relabelflag = RELABEL_BFS;
+        }
+        else if (strcasecmp(valstr, "rcm")==0)
+        {
+          g_options.bt_alg.relabelflag = RELABEL_RCM;
+        }
+        else
+        {
+          EXIT_ERROR1("Error: invalid +relabel value `%s'.\n", valstr);
+        }
+      }
+
       /* pruning backtrack parameters only */
       else if (g_options.algorithm == ALG_NOPRUNE_BT)
       {
@@ -688,6 +1849,10 @@ parse_backtrack_alg_options(
             case 'a':
               g_options.bt_alg.pruneoptflag |= HC_PRUNE_CUTPOINT;
               break;
+            case 'R':
+            case 'r':
+              g_options.bt_alg.pruneoptflag |= HC_PRUNE_REACH;
+              break;
             default:
           EXIT_ERROR1("Error: invalid +pruneopt value `%c'.\n", valstr[loop]);
               break;
@@ -710,6 +1875,18 @@ parse_backtrack_alg_options(
         {
           g_options.bt_alg.degsortflag = DEGSORT_MAX;
         }
+        else if (strcasecmp(valstr, "unvisited") == 0)
+        {
+          g_options.bt_alg.degsortflag = DEGSORT_UNVISIT;
+        }
+        else if (strcasecmp(valstr, "forcing") == 0)
+        {
+          g_options.bt_alg.degsortflag = DEGSORT_FORCE;
+        }
+        else if (strcasecmp(valstr, "conflict") == 0)
+        {
+          g_options.bt_alg.degsortflag = DEGSORT_CONFLICT;
+        }
         else
         {
           EXIT_ERROR1("Error: invalid +degsort value `%s'.\n", valstr);
@@ -727,6 +1904,61 @@ parse_backtrack_alg_options(
         }
       }
 
+      /* bidirflag parameter */
+      else if (strcasecmp(parmstr, "+bidir")==0)
+      {
+        g_options.bt_alg.bidirflag = BIDIR_ON;
+      }
+
+      /* parse memo table size parameter */
+      else if (strcasecmp(parmstr, "+memo")==0)
+      {
+        g_options.bt_alg.memo_mb = atoi(valstr);
+       
+        if (g_options.bt_alg.memo_mb < 0)
+        {
+          EXIT_ERROR("Memo table size invalid.\n");
+        }
+      }
+
+      /* parse cycle counting parameters */
+      else if (strcasecmp(parmstr, "+count")==0)
+      {
+        g_options.bt_alg.countflag = COUNT_ON;
+        g_options.bt_alg.count_cap = 0;
+        if (check_word(valstr) != WORD_EMPTY)
+          g_options.bt_alg.count_cap = atoi(valstr);
+
+        if (g_options.bt_alg.count_cap < 0)
+        {
+          EXIT_ERROR("Cycle count cap invalid.\n");
+        }
+      }
+
+      else if (strcasecmp(parmstr, "+countworkers")==0)
+      {
+        g_options.bt_alg.count_workers = atoi(valstr);
+
+        if ( (g_options.bt_alg.count_workers < 1) ||
+	     (g_options.bt_alg.count_workers > MAXCOUNTWORKERS) )
+        {
+          EXIT_ERROR1("# of count workers must be from 1 to %d.\n",
+		MAXCOUNTWORKERS);
+        }
+      }
+
+      else if (strcasecmp(parmstr, "+countie")==0)
+      {
+        g_options.bt_alg.count_iemax = atoi(valstr);
+
+        if ( (g_options.bt_alg.count_iemax < 0) ||
+	     (g_options.bt_alg.count_iemax > COUNT_IE_LIMIT) )
+        {
+          EXIT_ERROR1("Inclusion-exclusion count size must be from 0 to "
+		"%d.\n", COUNT_IE_LIMIT);
+        }
+      }
+
       else
       {
         WARN_ERROR1("Warning: Unidentified parameter `%s'.\n", parmstr);
@@ -759,6 +1991,14 @@ init_backtrack_alg_options()
 
   g_options.bt_alg.restart_increment = 0;
   g_options.bt_alg.max_nodes	     = 0;
+  g_options.bt_alg.contractflag	     = NOCONTRACT;
+  g_options.bt_alg.relabelflag	     = RELABEL_NONE;
+  g_options.bt_alg.memo_mb	     = 0;
+  g_options.bt_alg.bidirflag	     = BIDIR_OFF;
+  g_options.bt_alg.countflag	     = COUNT_OFF;
+  g_options.bt_alg.count_cap	     = 0;
+  g_options.bt_alg.count_workers     = 1;
+  g_options.bt_alg.count_iemax	     = COUNT_IE_MAXVERT;
 
 }  /* end of init_backtrack_alg_options() */
 
@@ -782,8 +2022,15 @@ print_backtrack_alg_options(
   else if (g_options.bt_alg.initvertflag == INITVERT_FIRST)
     fprintf(fp, "first vertex in graph\n");
 
+  if (g_options.bt_alg.contractflag == CONTRACT)
+    fprintf(fp, "    contract forced chains = yes\n");
+  if (g_options.bt_alg.relabelflag == RELABEL_BFS)
+    fprintf(fp, "    relabel vertices = bfs order\n");
+  else if (g_options.bt_alg.relabelflag == RELABEL_RCM)
+    fprintf(fp, "    relabel vertices = reverse cuthill-mckee order\n");
+
   /* pruning backtrack options only */
-  if (g_options.algorithm == ALG_BACKTRACK)
+  if (g_options.algorithm != ALG_NOPRUNE_BT)
   {
     fprintf(fp, "    sort visit list by method = ");
     if (g_options.bt_alg.degsortflag == DEGSORT_RAND)
@@ -792,6 +2039,14 @@ print_backtrack_alg_options(
       fprintf(fp, "min degree (increasing degree)\n");
     else if (g_options.bt_alg.degsortflag == DEGSORT_MAX)
       fprintf(fp, "max degree (decreasing degree)\n");
+    else if (g_options.bt_alg.degsortflag == DEGSORT_UNVISIT)
+      fprintf(fp, "fewest unvisited neighbours\n");
+    else if (g_options.bt_alg.degsortflag == DEGSORT_FORCE)
+      fprintf(fp, "most forced neighbours\n");
+    else if (g_options.bt_alg.degsortflag == DEGSORT_CONFLICT)
+      fprintf(fp, "conflict weight\n");
+    if (g_options.bt_alg.bidirflag == BIDIR_ON)
+      fprintf(fp, "    extend both ends of path = yes\n");
   }
 
   /* iterated restart, if specified */
@@ -801,6 +2056,24 @@ print_backtrack_alg_options(
       g_options.bt_alg.restart_increment);
   }
 
+  if (g_options.bt_alg.memo_mb > 0)
+  {
+    fprintf(fp, "    memo table size (MB) = %d\n", g_options.bt_alg.memo_mb);
+  }
+
+  if (g_options.bt_alg.countflag == COUNT_ON)
+  {
+    fprintf(fp, "    count hamiltonian cycles = ");
+    if (g_options.bt_alg.count_cap > 0)
+      fprintf(fp, "up to %d\n", g_options.bt_alg.count_cap);
+    else
+      fprintf(fp, "all\n");
+    fprintf(fp, "    count worker processes = %d\n", 
+	g_options.bt_alg.count_workers);
+    fprintf(fp, "    count by inclusion-exclusion up to = %d vertices\n",
+	g_options.bt_alg.count_iemax);
+  }
+
   fprintf(fp, "    graph pruning/checking options = ");
   if (g_options.bt_alg.pruneoptflag == HC_PRUNE_NONE)
   {
@@ -814,6 +2087,8 @@ print_backtrack_alg_options(
       fprintf(fp, "connected ");
     if (g_options.bt_alg.pruneoptflag & HC_PRUNE_CUTPOINT) 
       fprintf(fp, "cutpoints ");
+    if (g_options.bt_alg.pruneoptflag & HC_PRUNE_REACH) 
+      fprintf(fp, "reachability ");
     fprintf(fp, "\n");
   }
   
@@ -12,6 +12,13 @@
 #define DEGSORT_RAND 0
 #define DEGSORT_MIN 1
 #define DEGSORT_MAX 2
+#define DEGSORT_UNVISIT 3	/* dynamic scores, see bt_visit_score() */
+#define DEGSORT_FORCE 4
+#define DEGSORT_CONFLICT 5
+
+/* bidirflag parameters */
+#define BIDIR_OFF 0
+#define BIDIR_ON 1
 
 /* pruneoptflag parameters: are the same as the HC_PRUNE_X parameters */
 
@@ -24,6 +31,14 @@ typedef struct {
   int pruneoptflag;
   int restart_increment;
   int max_nodes;
+  int contractflag;	/* = CONTRACT or NOCONTRACT */
+  int relabelflag;	/* = RELABEL_NONE, RELABEL_BFS or RELABEL_RCM */
+  int memo_mb;		/* size of failed state memo table, 0 = none */
+  int bidirflag;	/* = BIDIR_ON (extend both path ends) or BIDIR_OFF */
+  int countflag;	/* = COUNT_ON or COUNT_OFF */
+  int count_cap;	/* stop counting at this many cycles, 0 = none */
+  int count_workers;	/* # of worker processes for the count */
+  int count_iemax;	/* count graphs up to this size by incl.-excl. */
 }  backtrack_alg_options_type;
 
 
@@ -0,0 +1,458 @@
+
+/* benchmark driver:  runs a fixed corpus of graph instances (one or more
+ * per graph generator, with fixed random seeds) through the algorithms,
+ * and records the nodes/sec, time and peak memory of each run.  results
+ * are either saved as a baseline file, or compared against one.
+ *
+ * Usage:  hcbench -w <baseline>                 record a new baseline
+ *         hcbench -c <baseline> [-p <percent>]  compare with a baseline
+ */
+
+/* system includes */
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+/* project includes */
+#include "main.h"
+
+
+/* defines */
+#define BENCH_DEF_PERCENT	10	/* allowed slowdown, in percent */
+#define BENCH_REPEAT		3	/* runs per instance, best one is kept */
+#define BENCH_TIMELIMIT		10	/* seconds, for each run */
+
+/* runs faster than this (seconds) are too noisy to compare timings */
+#define BENCH_MINTIME		0.05
+
+#define BENCH_WRITE	0
+#define BENCH_CHECK	1
+
+/* the corpus:  each entry is a graph type (generator options), an 
+ * algorithm (algorithm options), the number of graphs to solve, and the
+ * random seed that fixes the graphs.  the strings use the option file
+ * format.
+ * changing an entry makes its saved baseline meaningless, so add new
+ * entries instead, and re-record the baseline.
+ */
+typedef struct {
+  char *name;
+  char *graphopt;
+  char *algopt;
+  int numgraphs;
+  int seed;
+  }  bench_entry_type;
+
+#define BENCH_BT  "-algorithm backtrack +initvert=maxdeg +degsort=min +pruneopt=BCOA"
+#define BENCH_NB  "-algorithm noprune_bt +initvert=maxdeg"
+#define BENCH_PH  "-algorithm posa_heur +cycleextend"
+#define BENCH_AN  "-algorithm anneal"
+
+#define BENCH_GEO "-graphgen geometric +nvertex=400 +dist=0.09 +dim=2 +near +nowrap"
+#define BENCH_DB  "-graphgen degreebound +nvertex=800 +d2=0.02 +d3=0.3 +d4=0.68"
+#define BENCH_KT  "-graphgen knighttour +move1=1 +move2=2 +board1=8 +board2=8"
+#define BENCH_KTS "-graphgen knighttour +move1=1 +move2=2 +board1=6 +board2=6"
+#define BENCH_CR  "-graphgen crossroads +subgraphs=40"
+#define BENCH_RA  "-graphgen random +nvertex=800 +degconst=1.2"
+#define BENCH_AC  "-graphgen addcycle +nvertex=800 +numcycles=2.5"
+#define BENCH_AP  "-graphgen addpath +nvertex=400 +path1=1.0 +path2=0.9"
+#define BENCH_IC  "-graphgen iccs +subgraphs=30 +indsetsize=4"
+
+bench_entry_type g_bench_corpus[] = {
+  { "geo-ba", BENCH_GEO, BENCH_BT, 10, 101 },
+  { "geo-ph", BENCH_GEO, BENCH_PH, 10, 101 },
+  { "geo-an", BENCH_GEO, BENCH_AN, 10, 101 },
+  { "db-ba",  BENCH_DB,  BENCH_BT, 10, 102 },
+  { "db-ph",  BENCH_DB,  BENCH_PH, 10, 102 },
+  { "db-an",  BENCH_DB,  BENCH_AN, 10, 102 },
+  { "kt-ba",  BENCH_KT,  BENCH_BT, 10, 103 },
+  { "kt-nb",  BENCH_KTS, BENCH_NB,  2, 103 },
+  { "kt-ph",  BENCH_KT,  BENCH_PH, 10, 103 },
+  { "kt-an",  BENCH_KT,  BENCH_AN, 10, 103 },
+  { "cr-ba",  BENCH_CR,  BENCH_BT, 10, 104 },
+  { "cr-ph",  BENCH_CR,  BENCH_PH, 10, 104 },
+  { "ra-ba",  BENCH_RA,  BENCH_BT, 10, 105 },
+  { "ra-ph",  BENCH_RA,  BENCH_PH, 10, 105 },
+  { "ra-an",  BENCH_RA,  BENCH_AN, 10, 105 },
+  { "ac-ba",  BENCH_AC,  BENCH_BT, 10, 106 },
+  { "ac-ph",  BENCH_AC,  BENCH_PH, 10, 106 },
+  { "ac-an",  BENCH_AC,  BENCH_AN, 10, 106 },
+  { "ap-ba",  BENCH_AP,  BENCH_BT, 10, 107 },
+  { "ap-ph",  BENCH_AP,  BENCH_PH, 10, 107 },
+  { "ic-ba",  BENCH_IC,  BENCH_BT, 10, 108 },
+  { "ic-ph",  BENCH_IC,  BENCH_PH, 10, 108 },
+  };
+
+#define BENCH_NUMENTRY	(sizeof(g_bench_corpus) / sizeof(bench_entry_type))
+
+/* results of one benchmark run */
+typedef struct {
+  char name[STRLEN];
+  int numfound;		/* # of graphs a cycle was found on */
+  int numgraphs;
+  int nodes;		/* total over the graphs */
+  int fixednodes;	/* 1 if node count doesn't depend on timing */
+  float time;		/* wall clock time of the algorithm, in seconds */
+  float nodespersec;
+  long maxrss;		/* peak resident memory, in kilobytes */
+  }  bench_result_type;
+
+
+/************************************************************/
+/* this function runs a single corpus entry, in the (forked) child
+ * process.  the graphs are generated and solved, and the number solved,
+ * total node count and total solve time are written as a line of text 
+ * to fd
+ */
+void
+bench_child_run(
+  bench_entry_type *entry,
+  int fd)
+{
+  static graph_type graph;
+  stat_pertrial_type trialstat;
+  struct timeval start, stop;
+  float solvetime = 0.0;
+  int numfound = 0;
+  int nodes = 0;
+  int loop;
+  char optstr[4 * STRLEN];
+  char line[STRLEN];
+  FILE *fp;
+
+  /* set up the options, using the option file parser */
+  sprintf(optstr, "%s\n%s\n-graphtests %d\n-randseed %d\n-timelimit %d\n",
+	entry->graphopt, entry->algopt, entry->numgraphs, entry->seed,
+	BENCH_TIMELIMIT);
+  fp = fmemopen(optstr, strlen(optstr), "r");
+  if (fp == NULL)
+  {
+    EXIT_ERROR("Error opening benchmark option string.\n");
+  }
+
+  strcpy(g_options.options_fn, entry->name);
+  init_options();
+  parse_option_stream(fp);
+  fclose(fp);
+
+  srandom( g_options.rng_seed );
+  srand48( (long) g_options.rng_seed );
+
+  for (loop = 0; loop < g_options.num_graph_tests; loop++)
+  {
+    init_graph(&graph);
+    generate_graph(&graph);
+
+    gettimeofday(&start, NULL);
+    test_hc_alg(&graph, &trialstat);
+    gettimeofday(&stop, NULL);
+
+    solvetime += (stop.tv_sec - start.tv_sec) + 
+		(stop.tv_usec - start.tv_usec) / 1e6;
+    nodes += trialstat.nodes;
+    if (trialstat.result == HC_FOUND)
+      numfound++;
+  }
+
+  sprintf(line, "%d %d %f\n", numfound, nodes, solvetime);
+  if (write(fd, line, strlen(line)) != strlen(line))
+  {
+    EXIT_ERROR("Error writing benchmark result.\n");
+  }
+
+}  /* end of bench_child_run() */
+
+
+/************************************************************/
+/* this function runs a corpus entry BENCH_REPEAT times, each in a
+ * separate process (so the peak memory is for that run alone), and
+ * keeps the fastest run
+ * returns RET_ERROR if a run failed
+ */
+int
+bench_run_entry(
+  bench_entry_type *entry,
+  bench_result_type *res)
+{
+  int loop;
+  int fd[2];
+  int status;
+  int nread;
+  pid_t pid;
+  struct rusage usage;
+  char line[STRLEN];
+  float runtime;
+
+  strcpy(res->name, entry->name);
+  res->numgraphs = entry->numgraphs;
+  res->time = -1.0;
+  res->maxrss = 0;
+
+  for (loop = 0; loop < BENCH_REPEAT; loop++)
+  {
+    if (pipe(fd) != 0)
+    {
+      EXIT_ERROR("Error creating pipe for benchmark run.\n");
+    }
+    fflush(stdout);
+    fflush(stderr);
+
+    pid = fork();
+    if (pid < 0)
+    {
+      EXIT_ERROR("Error forking benchmark run.\n");
+    }
+    if (pid == 0)
+    {
+      close(fd[0]);
+      bench_child_run(entry, fd[1]);
+      _exit(0);
+    }
+
+    close(fd[1]);
+    nread = read(fd[0], line, STRLEN - 1);
+    close(fd[0]);
+
+    if ( (wait4(pid, &status, 0, &usage) != pid) ||
+	 !WIFEXITED(status) || (WEXITSTATUS(status) != 0) || (nread <= 0) )
+    {
+      WARN_ERROR1("Error: benchmark run `%s' failed.\n", entry->name);
+      return(RET_ERROR);
+    }
+    line[nread] = '\0';
+
+    if (sscanf(line, "%d %d %f", &res->numfound, &res->nodes, &runtime) != 3)
+    {
+      WARN_ERROR1("Error: bad result from benchmark run `%s'.\n",
+	entry->name);
+      return(RET_ERROR);
+    }
+
+    if ( (res->time < 0.0) || (runtime < res->time) )
+      res->time = runtime;
+    if (usage.ru_maxrss > res->maxrss)
+      res->maxrss = usage.ru_maxrss;
+  }
+
+  /* anneal reports moves/sec as its node count */
+  if (strstr(entry->algopt, "anneal") != NULL)
+  {
+    res->fixednodes = 0;
+    res->nodespersec = res->nodes / (float) res->numgraphs;
+  }
+  else
+  {
+    res->fixednodes = 1;
+    res->nodespersec = res->nodes / (res->time > 1e-6 ? res->time : 1e-6);
+  }
+
+  return(RET_OK);
+
+}  /* end of bench_run_entry() */
+
+
+/************************************************************/
+/* prints a benchmark result line, in the baseline file format */
+void
+bench_print_result(
+  FILE *fp,
+  bench_result_type *res)
+{
+  fprintf(fp, "%-8s %3d/%-3d %10d %10.4f %14.1f %8ld\n", res->name,
+	res->numfound, res->numgraphs, res->nodes, res->time,
+	res->nodespersec, res->maxrss);
+
+}  /* end of bench_print_result() */
+
+
+/************************************************************/
+/* this function looks up the result for the named run in the baseline
+ * file.  returns RET_OK if found, RET_ERROR otherwise
+ */
+int
+bench_read_baseline(
+  FILE *fp,
+  char name[],
+  bench_result_type *base)
+{
+  char line[STRLEN];
+
+  rewind(fp);
+  while (fgets(line, STRLEN, fp) != NULL)
+  {
+    if ( (line[0] == '#') ||
+	 (sscanf(line, "%s %d/%d %d %f %f %ld", base->name, &base->numfound,
+		&base->numgraphs, &base->nodes, &base->time, 
+		&base->nodespersec, &base->maxrss) != 7) )
+      continue;
+
+    if (strcmp(base->name, name) == 0)
+      return(RET_OK);
+  }
+
+  return(RET_ERROR);
+
+}  /* end of bench_read_baseline() */
+
+
+/************************************************************/
+/* this function compares a run with its baseline.  a run regresses if
+ * it is more than percent slower (in nodes/sec, or in time when the
+ * node counts differ or depend on timing), or uses more than percent 
+ * more memory.
+ * returns the number of regressions found (0 or 1)
+ */
+int
+bench_compare(
+  bench_result_type *res,
+  bench_result_type *base,
+  float percent)
+{
+  float limit = 1.0 + percent / 100.0;
+  int regress = 0;
+
+  if (base->time >= BENCH_MINTIME)
+  {
+    if ( (res->fixednodes) && (res->nodes == base->nodes) )
+    {
+      if (res->nodespersec * limit < base->nodespersec)
+        regress = 1;
+    }
+    else if (res->time > base->time * limit)
+      regress = 1;
+  }
+
+  if (res->maxrss > base->maxrss * limit)
+    regress = 1;
+
+  if (regress)
+  {
+    printf("  REGRESSION: %s (baseline %d nodes, %.4f sec, %.1f nodes/sec, "
+	"%ld KB)\n", res->name, base->nodes, base->time, base->nodespersec,
+	base->maxrss);
+  }
+  else if ( (res->fixednodes) && (res->nodes != base->nodes) )
+  {
+    printf("  note: %s node count changed from %d\n", res->name, base->nodes);
+  }
+
+  return(regress);
+
+}  /* end of bench_compare() */
+
+
+/************************************************************/
+/* main body of the benchmark driver
+ */
+/************************************************************/
+int
+main(
+  int argc,
+  char *argv[] )
+{
+  int mode = -1;
+  char base_fn[STRLEN];
+  FILE *base_fp = NULL;
+  float percent = BENCH_DEF_PERCENT;
+  int numregress = 0;
+  int numfail = 0;
+  int loop;
+  int ch;
+  bench_result_type res;
+  bench_result_type base;
+
+  opterr = 0;
+  while ( (ch = getopt(argc, argv, "w:c:p:h")) != -1)
+  {
+    switch(ch)
+    {
+      case 'w':
+        mode = BENCH_WRITE;
+        strcpy(base_fn, optarg);
+        break;
+
+      case 'c':
+        mode = BENCH_CHECK;
+        strcpy(base_fn, optarg);
+        break;
+
+      case 'p':
+        percent = atof(optarg);
+        break;
+
+      default:
+        mode = -1;
+        break;
+    }
+  }
+
+  if (mode == -1)
+  {
+    printf("Usage:  %s -w <baseline file>   : record a new baseline\n",
+	argv[0]);
+    printf("        %s -c <baseline file> [-p <percent>]\n", argv[0]);
+    printf("                                 : check for regressions "
+	"of more than percent\n");
+    exit(1);
+  }
+
+  if (mode == BENCH_WRITE)
+  {
+    base_fp = fopen(base_fn, "w");
+    if (base_fp == NULL)
+    {
+      EXIT_ERROR1("Error opening baseline file `%s' for writing.\n", base_fn);
+    }
+    fprintf(base_fp, "# name  found/graphs  nodes  time(sec)  nodes/sec  "
+	"maxrss(KB)\n");
+    printf("Recording benchmark baseline to `%s'...\n", base_fn);
+  }
+  else
+  {
+    base_fp = fopen(base_fn, "r");
+    if (base_fp == NULL)
+    {
+      EXIT_ERROR1("Error opening baseline file `%s' for reading.\n", base_fn);
+    }
+    printf("Comparing with benchmark baseline `%s' (threshold %.1f%%)...\n",
+	base_fn, percent);
+  }
+
+  for (loop = 0; loop < BENCH_NUMENTRY; loop++)
+  {
+    if (bench_run_entry(&g_bench_corpus[loop], &res) != RET_OK)
+    {
+      numfail++;
+      continue;
+    }
+    bench_print_result(stdout, &res);
+    fflush(stdout);
+
+    if (mode == BENCH_WRITE)
+    {
+      bench_print_result(base_fp, &res);
+    }
+    else if (bench_read_baseline(base_fp, res.name, &base) != RET_OK)
+    {
+      printf("  note: %s is not in the baseline\n", res.name);
+    }
+    else
+    {
+      numregress += bench_compare(&res, &base, percent);
+    }
+  }
+
+  fclose(base_fp);
+
+  if ( (numregress > 0) || (numfail > 0) )
+  {
+    printf("\nBenchmark FAILED:  %d regressions, %d failed runs.\n",
+	numregress, numfail);
+    exit(1);
+  }
+
+  printf("\nBenchmark passed.\n");
+  exit(0);
+
+}  /* end of main() */
+
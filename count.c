@@ -0,0 +1,257 @@
+
+#define IN_COUNT_FILE
+
+/* project includes */
+#include "main.h"
+
+
+/************************************************************/
+/* hamiltonian cycle counting (-algorithm backtrack +count)
+ *
+ * the pruning backtrack counts the cycles instead of stopping at the
+ * first one (the search hooks are in backtrack.c).  this file has the
+ * inclusion-exclusion count used instead of the search for small
+ * graphs, the frames the count workers send back, and the printing of
+ * the counts.
+ */
+/************************************************************/
+
+/* what each count worker writes to its pipe, followed by the cycle it
+ * found (numvert ints) if found is 1
+ */
+typedef struct {
+  long long count;
+  int exact;
+  int found;
+  int nodes;
+  int edgeprune;
+  }  count_frame_type;
+
+
+/************************************************************/
+/* this function counts the hamiltonian cycles of a graph of at most
+ * COUNT_IE_LIMIT vertices by inclusion-exclusion over the vertex sets
+ * that closed walks of length numvert from vertex 0 are kept to:
+ *
+ *   2 * # cycles = sum over S (subset of V - {0}) of
+ *                  (-1)^|V - {0} - S| * # closed walks in S + {0}
+ *
+ * the walks are counted modulo 2^64, which gives the exact sum since it
+ * is at most (numvert - 1)!, and 20! < 2^63 (COUNT_IE_LIMIT is 21)
+ */
+long long
+count_ie_cycles(
+  graph_type *graph)
+{
+  unsigned long long walks[COUNT_IE_LIMIT];
+  unsigned long long next[COUNT_IE_LIMIT];
+  unsigned long long sum;
+  unsigned long long total = 0;
+  unsigned int nbrmask[COUNT_IE_LIMIT];
+  unsigned int subset, inset, bits, nbrbits;
+  int numvert = graph->numvert;
+  int numother = numvert - 1;
+  int loop, eloop, step;
+  int v;
+
+  for (loop = 0; loop < numvert; loop++)
+  {
+    nbrmask[loop] = 0;
+    for (eloop = 0; eloop < graph->deg[loop]; eloop++)
+      nbrmask[loop] |= 1u << graph->nbr[loop][eloop];
+  }
+
+  for (subset = 0; subset < (1u << numother); subset++)
+  {
+    inset = (subset << 1) | 1;
+
+    for (loop = 0; loop < numvert; loop++)
+      walks[loop] = 0;
+    walks[0] = 1;
+
+    for (step = 0; step < numvert; step++)
+    {
+      for (bits = inset; bits != 0; bits &= bits - 1)
+      {
+        v = __builtin_ctz(bits);
+        sum = 0;
+        for (nbrbits = nbrmask[v] & inset; nbrbits != 0;
+		nbrbits &= nbrbits - 1)
+          sum += walks[__builtin_ctz(nbrbits)];
+        next[v] = sum;
+      }
+      for (bits = inset; bits != 0; bits &= bits - 1)
+      {
+        v = __builtin_ctz(bits);
+        walks[v] = next[v];
+      }
+    }
+
+    if ((numother - __builtin_popcount(subset)) & 1)
+      total -= walks[0];
+    else
+      total += walks[0];
+  }
+
+  /* each cycle is walked in both directions */
+  return( (long long) (total / 2) );
+
+}  /* end of count_ie_cycles() */
+
+
+/************************************************************/
+/* this function writes a counted cycle (search graph labels, numvert
+ * vertices) to the solution file, in the format of test_hc_alg()
+ */
+void
+count_write_cycle(
+  int cycle[],
+  int numvert)
+{
+  int solution[MAXVERT];
+  int loop;
+
+  memcpy(solution, cycle, numvert * sizeof(int));
+  if (g_count.reduce != NULL)
+  {
+    hc_expand_solution(g_count.reduce, solution);
+    numvert = g_count.reduce->numvert;
+  }
+
+  fprintf(g_options.sol_fp, "Cycle \n");
+  for (loop = 0; loop < numvert; loop++)
+  {
+    fprintf(g_options.sol_fp,"%4d ", solution[loop]);
+    if ( (loop+1)%10 == 0)
+      fprintf(g_options.sol_fp, "\n");
+  }
+  if (loop % 10 != 0)
+    fprintf(g_options.sol_fp, "\n");
+
+}  /* end of count_write_cycle() */
+
+
+/************************************************************/
+/* this function writes the count of a worker (g_count, and the nodes
+ * and pruned edges in trialstats) to its pipe.  numvert is the # of
+ * vertices of the search graph.  returns RET_ERROR if the write failed
+ */
+int
+count_write_result(
+  int fd,
+  stat_pertrial_type *trialstats,
+  int numvert)
+{
+  count_frame_type frame;
+
+  frame.count = g_count.count;
+  frame.exact = g_count.exact;
+  frame.found = g_count.found;
+  frame.nodes = trialstats->nodes;
+  frame.edgeprune = trialstats->edgeprune;
+
+  if (pipe_write(fd, &frame, sizeof(frame)) != RET_OK)
+    return(RET_ERROR);
+
+  if (frame.found)
+    return(pipe_write(fd, g_count.solution, numvert * sizeof(int)));
+
+  return(RET_OK);
+
+}  /* end of count_write_result() */
+
+
+/************************************************************/
+/* this function reads the count of a worker from its pipe, and adds it
+ * to g_count and trialstats.  the first cycle read is kept.  returns
+ * RET_ERROR if the worker didn't send its count
+ */
+int
+count_read_result(
+  int fd,
+  stat_pertrial_type *trialstats,
+  int numvert)
+{
+  count_frame_type frame;
+  int cycle[MAXVERT];
+
+  if (pipe_read(fd, &frame, sizeof(frame)) != RET_OK)
+    return(RET_ERROR);
+
+  if (frame.found)
+  {
+    if (pipe_read(fd, cycle, numvert * sizeof(int)) != RET_OK)
+      return(RET_ERROR);
+
+    if (!g_count.found)
+    {
+      memcpy(g_count.solution, cycle, numvert * sizeof(int));
+      g_count.found = 1;
+    }
+  }
+
+  g_count.count += frame.count;
+  if (frame.exact > g_count.exact)
+    g_count.exact = frame.exact;
+  trialstats->nodes += frame.nodes;
+  trialstats->edgeprune += frame.edgeprune;
+
+  return(RET_OK);
+
+}  /* end of count_read_result() */
+
+
+/************************************************************/
+/* this function prints the cycle count of a trial (to the log file) */
+void
+print_count_result(
+  FILE *fp,
+  stat_pertrial_type *trialstats)
+{
+  fprintf(fp, "Counted %lld hamiltonian cycles", trialstats->hccount);
+  if (trialstats->countexact == COUNT_CAPPED)
+    fprintf(fp, " (stopped at the cap)");
+  else if (trialstats->countexact == COUNT_PARTIAL)
+    fprintf(fp, " (stopped at the limit, at least this many)");
+
+  if (g_count.method == COUNT_BY_IE)
+    fprintf(fp, " by inclusion-exclusion");
+  else if (g_count.numworkers > 1)
+    fprintf(fp, " by search with %d workers", g_count.numworkers);
+  else
+    fprintf(fp, " by search");
+
+  fprintf(fp, ", %.2f sec (%.2f cpu sec)", g_count.walltime,
+	trialstats->time);
+  if (g_count.walltime > 0.0)
+    fprintf(fp, ", %.0f cycles/sec", trialstats->hccount / g_count.walltime);
+  fprintf(fp, ".\n");
+
+}  /* end of print_count_result() */
+
+
+/************************************************************/
+/* this function prints the cycle count and the cycles per (cpu) second
+ * of a trial, as tab separated columns for the stats file.  counts that
+ * stopped early are marked with a "+"
+ */
+void
+print_trial_count_stats(
+  FILE *fp,
+  stat_pertrial_type *trialstats)
+{
+  if (trialstats->hccount < 0)
+  {
+    fprintf(fp, "\t-\t-");
+    return;
+  }
+
+  fprintf(fp, "\t%lld%s", trialstats->hccount,
+	(trialstats->countexact == COUNT_EXACT) ? "" : "+");
+  if (trialstats->time > 0.0)
+    fprintf(fp, "\t%.0f", trialstats->hccount / trialstats->time);
+  else
+    fprintf(fp, "\t-");
+
+}  /* end of print_trial_count_stats() */
+
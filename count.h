@@ -0,0 +1,88 @@
+
+
+#ifndef _COUNT_H_
+#define _COUNT_H_
+
+
+/************************************************************/
+/* defines and data structures */
+/************************************************************/
+
+/* countflag parameter of the backtrack options */
+#define COUNT_OFF	0
+#define COUNT_ON	1
+
+/* graphs (after the initial pruning) of up to this many vertices are
+ * counted by inclusion-exclusion (default of +countie), and the most
+ * that +countie can be set to.  the limit keeps twice the # of cycles,
+ * at most (numvert - 1)!, below 2^63 (21! is past 2^64)
+ */
+#define COUNT_IE_MAXVERT	20
+#define COUNT_IE_LIMIT		21
+
+/* the most worker processes (+countworkers) */
+#define MAXCOUNTWORKERS		64
+
+/* the workers split the search tree at this path length (or half the
+ * # of vertices, if less), each searching the subtrees whose paths hash
+ * to it
+ */
+#define COUNT_SPLITDEPTH	12
+
+/* how far a count got */
+#define COUNT_EXACT	0	/* all the cycles were counted */
+#define COUNT_CAPPED	1	/* stopped at the cap (+count=<cap>) */
+#define COUNT_PARTIAL	2	/* stopped at the time or node limit */
+
+/* state of the cycle count of a trial.  the search counts each cycle
+ * once, in the direction that leaves the start vertex through the
+ * first of its 2 cycle neighbours that is tried
+ */
+typedef struct {
+  int on;
+  long long cap;		/* stop after this many cycles, 0 = no cap */
+  long long count;
+  int exact;			/* COUNT_EXACT, COUNT_CAPPED or COUNT_PARTIAL */
+  int method;			/* COUNT_BY_SEARCH or COUNT_BY_IE */
+  int enumerate;		/* 1 if each cycle is written to the .sol file */
+  int worker;			/* this worker, and # of workers */
+  int numworkers;
+  int splitdepth;
+  long long skipped;		/* # of subtrees left to the other workers */
+  hc_reduce_type *reduce;	/* maps the search graph back to the graph,
+				 * NULL if the labels are the same */
+  float walltime;		/* elapsed (not cpu) seconds of the count */
+  int found;			/* 1 once solution[] holds a cycle */
+  int solution[MAXVERT];	/* first cycle (search graph labels) */
+  }  count_type;
+
+#define COUNT_BY_SEARCH	0
+#define COUNT_BY_IE	1
+
+#ifdef IN_COUNT_FILE
+count_type g_count;
+#else
+extern count_type g_count;
+#endif
+
+
+/************************************************************/
+/* function declarations */
+/************************************************************/
+
+long long count_ie_cycles( graph_type *graph);
+
+void count_write_cycle( int cycle[], int numvert);
+
+int count_write_result( int fd, stat_pertrial_type *trialstats,
+	int numvert);
+
+int count_read_result( int fd, stat_pertrial_type *trialstats,
+	int numvert);
+
+void print_count_result( FILE *fp, stat_pertrial_type *trialstats);
+
+void print_trial_count_stats( FILE *fp, stat_pertrial_type *trialstats);
+
+#endif /* _COUNT_H_ */
+
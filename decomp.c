@@ -0,0 +1,1253 @@
+/* project includes */
+#include "main.h"
+
+
+/************************************************************/
+/* decomposition solver (-algorithm decomp)
+ *
+ * if removing 2 vertices {a,b} splits the graph into the sides C1 and
+ * C2, a hamiltonian cycle has to go from a to b through all of C1 and
+ * back from b to a through all of C2.  so the graph is split into the
+ * pieces C1+{a,b} and C2+{a,b}, each with a new vertex x of degree 2
+ * joined to a and b (forcing the a-x-b part of the cycle), and the graph
+ * has a cycle if and only if both pieces have one.  the pieces are split
+ * again till no 2-vertex cut is left, and the blocks are then solved by
+ * the pruning backtrack algorithm (with the backtrack parameters).  the
+ * cycles of the pieces are joined back together by dropping the x's.
+ *
+ * a 3-vertex cut {a,b,c} can be crossed in 6 ways (types):  a side is
+ * crossed by one path between 2 of the cut vertices, with the third
+ * inside it or not, and the other side by the path between the same 2
+ * with the third on the other side.  the smallest side S of a 3-cut is
+ * solved for each type, then replaced by a gadget, a graph of at most
+ * DECOMP_MAXGADGET new vertices that is crossed by exactly the types S
+ * is, and the smaller graph is solved.  the gadget's path in its cycle
+ * is then replaced by the path through S of the same type.  (if no
+ * gadget has S's types, the graph is solved with a gadget for each of
+ * S's types in turn)
+ *
+ * the blocks are kept in a memo, keyed by vertex colours refined from
+ * the degrees, so that a block the same as one already solved (up to
+ * the vertex labels, as found by a search matching the 2) isn't solved
+ * again.
+ *
+ * this suits graphs made of small subgraphs strung together through
+ * pairs or triples of vertices (crossroads graphs, and iccs graphs with
+ * +indsetsize=3), which the backtrack algorithm alone can take
+ * exponential time on.
+ */
+/************************************************************/
+
+decomp_memo_type g_blockmemo;
+
+
+/************************************************************/
+/* this function looks at the dfs subtree of c (a child of b in the dfs
+ * of the graph without the dfs->cut vertices), which is a side of the
+ * cut of those vertices and b.  for a 2-cut the split is kept if its
+ * smaller side is bigger than that of the best split so far, for a
+ * 3-cut if the side of c is smaller
+ */
+void
+decomp_try_split(
+  graph_type *graph,
+  decomp_dfs_type *dfs,
+  decomp_split_type *split,
+  int b,
+  int c)
+{
+  int side = dfs->size[c];
+  int other = graph->numvert - dfs->numout - 1 - side;
+  int minside = (side < other) ? side : other;
+
+  if (dfs->numout == 1)
+  {
+    if ( (minside >= DECOMP_MINSIDE) && (minside > split->minside) )
+    {
+      split->cut[0] = dfs->cut[0];
+      split->cut[1] = b;
+      split->numcut = 2;
+      split->c = c;
+      split->minside = minside;
+    }
+  }
+  else if ( (minside >= DECOMP_MINSIDE3) && (side < split->minside) )
+  {
+    split->cut[0] = dfs->cut[0];
+    split->cut[1] = dfs->cut[1];
+    split->cut[2] = b;
+    split->numcut = 3;
+    split->c = c;
+    split->minside = side;
+  }
+
+}  /* end of decomp_try_split() */
+
+
+/************************************************************/
+/* recursive dfs for the cut vertices of the graph without the dfs->cut
+ * vertices.  for a vertex v (not the root), a child w with
+ * low[w] >= disc[v] has a subtree that is only joined to the rest
+ * through v (and the dfs->cut vertices)
+ */
+void
+decomp_dfs(
+  graph_type *graph,
+  decomp_dfs_type *dfs,
+  decomp_split_type *split,
+  int v)
+{
+  int eloop;
+  int w;
+
+  dfs->disc[v] = dfs->low[v] = ++(dfs->time);
+  dfs->size[v] = 1;
+
+  for (eloop = 0; eloop < graph->deg[v]; eloop++)
+  {
+    w = graph->nbr[v][eloop];
+    if (dfs->out[w])
+      continue;
+
+    if (dfs->disc[w] == 0)
+    {
+      dfs->parent[w] = v;
+      decomp_dfs(graph, dfs, split, w);
+      dfs->size[v] += dfs->size[w];
+      if (dfs->low[w] < dfs->low[v])
+        dfs->low[v] = dfs->low[w];
+
+      if ( (v != dfs->root) && (dfs->low[w] >= dfs->disc[v]) )
+        decomp_try_split(graph, dfs, split, v, w);
+    }
+    else if ( (w != dfs->parent[v]) && (dfs->disc[w] < dfs->low[v]) )
+    {
+      dfs->low[v] = dfs->disc[w];
+    }
+  }
+
+}  /* end of decomp_dfs() */
+
+
+/************************************************************/
+/* this function does the dfs of the graph without the dfs->cut
+ * vertices, from the first vertex left, and tries the splits at the
+ * root if it is a cut vertex.
+ * returns 1 if the dfs reached all the vertices left, 0 if not
+ */
+int
+decomp_dfs_graph(
+  graph_type *graph,
+  decomp_dfs_type *dfs,
+  decomp_split_type *split)
+{
+  int numvert = graph->numvert;
+  int eloop;
+  int w;
+  int children;
+
+  memset(dfs->disc, 0, numvert * sizeof(int));
+  dfs->time = 0;
+  for (dfs->root = 0; dfs->out[dfs->root]; dfs->root++)
+    ;
+  dfs->parent[dfs->root] = -1;
+
+  decomp_dfs(graph, dfs, split, dfs->root);
+
+  if (dfs->time < numvert - dfs->numout)
+    return(0);
+
+  /* the root is a cut vertex if it has more than one dfs child */
+  children = 0;
+  for (eloop = 0; eloop < graph->deg[dfs->root]; eloop++)
+  {
+    w = graph->nbr[dfs->root][eloop];
+    if ( (!dfs->out[w]) && (dfs->parent[w] == dfs->root) )
+      children++;
+  }
+  if (children > 1)
+  {
+    for (eloop = 0; eloop < graph->deg[dfs->root]; eloop++)
+    {
+      w = graph->nbr[dfs->root][eloop];
+      if ( (!dfs->out[w]) && (dfs->parent[w] == dfs->root) )
+        decomp_try_split(graph, dfs, split, dfs->root, w);
+    }
+  }
+
+  return(1);
+
+}  /* end of decomp_dfs_graph() */
+
+
+/************************************************************/
+/* this function finds the 2-vertex cut {a,b} of the graph with the
+ * largest smaller side (so the pieces are about the same size).
+ * one dfs is done without each vertex a.
+ * returns SPLIT_FOUND, SPLIT_NONE, or SPLIT_NOHC if the graph has a cut
+ * vertex
+ */
+int
+decomp_find_split(
+  graph_type *graph,
+  decomp_split_type *split)
+{
+  decomp_dfs_type *dfs = ARENA_NEW(decomp_dfs_type);
+  int numvert = graph->numvert;
+  int loop;
+  int ret;
+
+  split->minside = DECOMP_MINSIDE - 1;
+  memset(dfs->out, 0, numvert * sizeof(char));
+  dfs->numout = 1;
+
+  for (loop = 0; loop < numvert; loop++)
+  {
+    dfs->cut[0] = loop;
+    dfs->out[loop] = 1;
+    ret = decomp_dfs_graph(graph, dfs, split);
+    dfs->out[loop] = 0;
+
+    /* not everything reached, so loop is a cut vertex */
+    if (ret == 0)
+      return(SPLIT_NOHC);
+
+    /* can't do better than an even split */
+    if (split->minside >= (numvert - 2) / 2)
+      break;
+  }
+
+  if (split->minside < DECOMP_MINSIDE)
+    return(SPLIT_NONE);
+
+  return(SPLIT_FOUND);
+
+}  /* end of decomp_find_split() */
+
+
+/************************************************************/
+/* this function finds the 3-vertex cut {a,b,c} of the graph with the
+ * smallest side (of at least DECOMP_MINSIDE3 vertices, as the other
+ * side must be), with a dfs without each pair of vertices {a,b}.
+ * returns SPLIT_FOUND or SPLIT_NONE
+ */
+int
+decomp_find_split3(
+  graph_type *graph,
+  decomp_split_type *split)
+{
+  decomp_dfs_type *dfs = ARENA_NEW(decomp_dfs_type);
+  int numvert = graph->numvert;
+  int loop1, loop2;
+
+  split->minside = numvert;
+  memset(dfs->out, 0, numvert * sizeof(char));
+  dfs->numout = 2;
+
+  for (loop1 = 0; loop1 < numvert; loop1++)
+  {
+    dfs->cut[0] = loop1;
+    dfs->out[loop1] = 1;
+    for (loop2 = loop1 + 1; loop2 < numvert; loop2++)
+    {
+      /* (if {a,b} is a cut, its small side is too small to split at) */
+      dfs->cut[1] = loop2;
+      dfs->out[loop2] = 1;
+      decomp_dfs_graph(graph, dfs, split);
+      dfs->out[loop2] = 0;
+
+      if (split->minside == DECOMP_MINSIDE3)
+        break;
+    }
+    dfs->out[loop1] = 0;
+
+    if (split->minside == DECOMP_MINSIDE3)
+      break;
+  }
+
+  if (split->minside == numvert)
+    return(SPLIT_NONE);
+
+  return(SPLIT_FOUND);
+
+}  /* end of decomp_find_split3() */
+
+
+/************************************************************/
+/* this function sets side[v] to 0 for the cut vertices of the split,
+ * 1 for the vertices of its side with split->c, and 2 for the rest.
+ * returns the # of vertices on side 1
+ */
+int
+decomp_label_sides(
+  graph_type *graph,
+  decomp_split_type *split,
+  int side[])
+{
+  int *queue = ARENA_ARRAY(int, graph->numvert);
+  int qhead, qtail;
+  int loop, eloop;
+  int v, w;
+
+  for (loop = 0; loop < graph->numvert; loop++)
+    side[loop] = 2;
+  for (loop = 0; loop < split->numcut; loop++)
+    side[split->cut[loop]] = 0;
+  side[split->c] = 1;
+  queue[0] = split->c;
+  for (qhead = 0, qtail = 1; qhead < qtail; qhead++)
+  {
+    v = queue[qhead];
+    for (eloop = 0; eloop < graph->deg[v]; eloop++)
+    {
+      w = graph->nbr[v][eloop];
+      if (side[w] == 2)
+      {
+        side[w] = 1;
+        queue[qtail++] = w;
+      }
+    }
+  }
+
+  return(qtail);
+
+}  /* end of decomp_label_sides() */
+
+
+/************************************************************/
+/* this function builds the piece of the graph made of the side
+ * side[v] == sidenum of the split, the cut vertices x and y (and z,
+ * unless it is -1) and the new vertex u (the last vertex of the piece),
+ * joined to x and y.  the edges between the cut vertices are left out:
+ * (x,y) can't be on a cycle that goes through both sides, and a cycle
+ * of the graph that uses (x,z) or (z,y) crosses the side as a path
+ * without z (the edge goes with the other side).  map[] gives the
+ * graph vertex of each piece vertex (-1 for u)
+ */
+void
+decomp_make_piece(
+  graph_type *graph,
+  int side[],
+  int sidenum,
+  int x,
+  int y,
+  int z,
+  graph_type *piece,
+  int map[])
+{
+  int newid[MAXVERT];
+  int numvert = 0;
+  int loop, eloop;
+  int w;
+
+  for (loop = 0; loop < graph->numvert; loop++)
+  {
+    if ( (loop == x) || (loop == y) || (loop == z) ||
+	 (side[loop] == sidenum) )
+    {
+      newid[loop] = numvert;
+      map[numvert++] = loop;
+    }
+    else
+      newid[loop] = -1;
+  }
+
+  init_graph(piece);
+  piece->numvert = numvert + 1;
+  map[numvert] = -1;
+
+  for (loop = 0; loop < graph->numvert; loop++)
+  {
+    if (newid[loop] == -1)
+      continue;
+
+    for (eloop = 0; eloop < graph->deg[loop]; eloop++)
+    {
+      w = graph->nbr[loop][eloop];
+      if ( (newid[w] == -1) ||
+	   ( (side[loop] != sidenum) && (side[w] != sidenum) ) )
+        continue;
+
+      add_direct_edge_graph(piece, newid[loop], newid[w]);
+    }
+  }
+
+  add_edge_graph(piece, newid[x], numvert);
+  add_edge_graph(piece, newid[y], numvert);
+
+}  /* end of decomp_make_piece() */
+
+
+/************************************************************/
+/* this function turns the cycle of a piece into the path (in graph
+ * vertices) from the graph vertex <from> (next to x in the cycle) to
+ * the other neighbour of x, leaving x out.  returns the path length
+ */
+int
+decomp_piece_path(
+  int piecesol[],
+  int numvert,
+  int map[],
+  int from,
+  int path[])
+{
+  int loop;
+  int xpos;
+  int dir;
+  int pos;
+
+  for (xpos = 0; map[piecesol[xpos]] != -1; xpos++)
+    ;
+
+  /* walk away from x, starting on the side of <from> */
+  if (map[piecesol[(xpos + 1) % numvert]] == from)
+    dir = 1;
+  else
+    dir = numvert - 1;
+
+  for (loop = 0, pos = (xpos + dir) % numvert; loop < numvert - 1;
+	loop++, pos = (pos + dir) % numvert)
+  {
+    path[loop] = map[piecesol[pos]];
+  }
+
+  return(numvert - 1);
+
+}  /* end of decomp_piece_path() */
+
+
+/************************************************************/
+/* block memo routines
+ */
+/************************************************************/
+
+/************************************************************/
+/* mixes the bits of x (splitmix64 finalizer) */
+unsigned long long
+decomp_mix(
+  unsigned long long x)
+{
+  x ^= x >> 30;
+  x *= 0xBF58476D1CE4E5B9ULL;
+  x ^= x >> 27;
+  x *= 0x94D049BB133111EBULL;
+  x ^= x >> 31;
+
+  return(x);
+
+}  /* end of decomp_mix() */
+
+
+/************************************************************/
+/* this function gives each vertex of a block (of at most
+ * DECOMP_MEMOVERT vertices) a colour, starting from its degree and
+ * refined by the colours of its neighbours till the # of colours stops
+ * growing.  the colours don't depend on the vertex labels, so a block
+ * the same as another up to the labels has the same colours.
+ * sets adj[] to the neighbours of each vertex (bit masks), and returns
+ * the key of the block
+ */
+unsigned long long
+decomp_block_colour(
+  graph_type *graph,
+  unsigned long long adj[],
+  unsigned long long col[])
+{
+  unsigned long long newcol[DECOMP_MEMOVERT];
+  unsigned long long sum;
+  unsigned long long key;
+  int numvert = graph->numvert;
+  int numcol, lastcol = 0;
+  int loop, eloop;
+  int round;
+
+  for (loop = 0; loop < numvert; loop++)
+  {
+    adj[loop] = 0;
+    for (eloop = 0; eloop < graph->deg[loop]; eloop++)
+      adj[loop] |= 1ULL << graph->nbr[loop][eloop];
+    col[loop] = decomp_mix(graph->deg[loop] + 1);
+  }
+
+  for (round = 0; round < numvert; round++)
+  {
+    for (loop = 0; loop < numvert; loop++)
+    {
+      sum = 0;
+      for (eloop = 0; eloop < graph->deg[loop]; eloop++)
+        sum += decomp_mix(col[graph->nbr[loop][eloop]] + 1);
+      newcol[loop] = decomp_mix(col[loop] * 31 + sum);
+    }
+
+    /* count the colours */
+    numcol = 0;
+    for (loop = 0; loop < numvert; loop++)
+    {
+      col[loop] = newcol[loop];
+      for (eloop = 0; eloop < loop; eloop++)
+      {
+        if (newcol[eloop] == newcol[loop])
+          break;
+      }
+      if (eloop == loop)
+        numcol++;
+    }
+
+    if (numcol == lastcol)
+      break;
+    lastcol = numcol;
+  }
+
+  key = decomp_mix(numvert);
+  for (loop = 0; loop < numvert; loop++)
+    key += decomp_mix(col[loop]);
+
+  return(key);
+
+}  /* end of decomp_block_colour() */
+
+
+/************************************************************/
+/* recursive search for a mapping f[] of the block's vertices onto the
+ * memoised block's that keeps the colours and edges.  the block's
+ * vertices are mapped in the order order[], each (after the first) next
+ * to the already mapped vertex parent[].
+ * returns 1 if the mapping was completed, 0 if not
+ */
+int
+decomp_iso_extend(
+  unsigned long long adj[],
+  unsigned long long col[],
+  decomp_memo_entry_type *entry,
+  int order[],
+  int parent[],
+  int f[],
+  unsigned long long mapped,
+  unsigned long long used,
+  int index,
+  int *steps)
+{
+  unsigned long long cand;
+  unsigned long long image;
+  unsigned long long bits;
+  int v = order[index];
+  int w;
+
+  if (index == entry->numvert)
+    return(1);
+
+  if (index == 0)
+    cand = (entry->numvert == 64) ? ~0ULL : (1ULL << entry->numvert) - 1;
+  else
+    cand = entry->adj[f[parent[index]]] & ~used;
+
+  /* the images of v's mapped neighbours */
+  image = 0;
+  for (bits = adj[v] & mapped; bits != 0; bits &= bits - 1)
+    image |= 1ULL << f[__builtin_ctzll(bits)];
+
+  for ( ; cand != 0; cand &= cand - 1)
+  {
+    w = __builtin_ctzll(cand);
+    if ( (entry->col[w] != col[v]) || ((entry->adj[w] & used) != image) )
+      continue;
+
+    if (++(*steps) > DECOMP_ISOSTEPS)
+      return(0);
+
+    f[v] = w;
+    if (decomp_iso_extend(adj, col, entry, order, parent, f,
+	  mapped | (1ULL << v), used | (1ULL << w), index + 1, steps))
+      return(1);
+  }
+
+  return(0);
+
+}  /* end of decomp_iso_extend() */
+
+
+/************************************************************/
+/* this function looks for the block in the memo.  if found, the
+ * result is returned (with the cycle, relabelled, in solution[]),
+ * else HC_NOT_FOUND
+ */
+int
+decomp_memo_find(
+  int numvert,
+  unsigned long long key,
+  unsigned long long adj[],
+  unsigned long long col[],
+  int solution[])
+{
+  decomp_memo_entry_type *entry;
+  int order[DECOMP_MEMOVERT];
+  int parent[DECOMP_MEMOVERT];
+  int f[DECOMP_MEMOVERT];
+  int finv[DECOMP_MEMOVERT];
+  unsigned long long seen;
+  unsigned long long bits;
+  int qhead, qtail;
+  int start;
+  int count, mincount;
+  int loop, eloop;
+  int steps;
+  int v, w;
+
+  /* map the vertices in bfs order from one of the rarest colour */
+  start = 0;
+  mincount = numvert + 1;
+  for (loop = 0; loop < numvert; loop++)
+  {
+    for (count = 0, eloop = 0; eloop < numvert; eloop++)
+    {
+      if (col[eloop] == col[loop])
+        count++;
+    }
+    if (count < mincount)
+    {
+      mincount = count;
+      start = loop;
+    }
+  }
+
+  order[0] = start;
+  parent[0] = -1;
+  seen = 1ULL << start;
+  for (qhead = 0, qtail = 1; qhead < qtail; qhead++)
+  {
+    v = order[qhead];
+    for (bits = adj[v] & ~seen; bits != 0; bits &= bits - 1)
+    {
+      w = __builtin_ctzll(bits);
+      seen |= 1ULL << w;
+      parent[qtail] = v;
+      order[qtail++] = w;
+    }
+  }
+  if (qtail < numvert)
+    return(HC_NOT_FOUND);
+
+  for (loop = 0; loop < g_blockmemo.numentry; loop++)
+  {
+    entry = &(g_blockmemo.entry[loop]);
+    if ( (entry->key != key) || (entry->numvert != numvert) )
+      continue;
+
+    steps = 0;
+    if (decomp_iso_extend(adj, col, entry, order, parent, f, 0, 0, 0,
+	  &steps))
+    {
+      if (entry->ret == HC_FOUND)
+      {
+        for (v = 0; v < numvert; v++)
+          finv[f[v]] = v;
+        for (v = 0; v < numvert; v++)
+          solution[v] = finv[entry->solution[v]];
+      }
+      return(entry->ret);
+    }
+  }
+
+  return(HC_NOT_FOUND);
+
+}  /* end of decomp_memo_find() */
+
+
+/************************************************************/
+/* this function keeps a solved block in the memo (replacing the oldest
+ * one when it is full)
+ */
+void
+decomp_memo_store(
+  int numvert,
+  unsigned long long key,
+  unsigned long long adj[],
+  unsigned long long col[],
+  int ret,
+  int solution[])
+{
+  decomp_memo_entry_type *entry;
+
+  if (g_blockmemo.numentry < DECOMP_MEMOSIZE)
+    entry = &(g_blockmemo.entry[g_blockmemo.numentry++]);
+  else
+  {
+    entry = &(g_blockmemo.entry[g_blockmemo.next]);
+    g_blockmemo.next = (g_blockmemo.next + 1) % DECOMP_MEMOSIZE;
+  }
+
+  entry->key = key;
+  entry->numvert = numvert;
+  entry->ret = ret;
+  memcpy(entry->adj, adj, numvert * sizeof(unsigned long long));
+  memcpy(entry->col, col, numvert * sizeof(unsigned long long));
+  if (ret == HC_FOUND)
+    memcpy(entry->solution, solution, numvert * sizeof(int));
+
+}  /* end of decomp_memo_store() */
+
+
+/************************************************************/
+/* this function solves a block (a graph without a 2-vertex cut) with
+ * the pruning backtrack algorithm, unless the same block is in the
+ * block memo
+ */
+int
+decomp_solve_block(
+  graph_type *graph,
+  int solution[],
+  decomp_stats_type *dstats)
+{
+  stat_pertrial_type blockstat;
+  arena_mark_type mark;
+  unsigned long long adj[DECOMP_MEMOVERT];
+  unsigned long long col[DECOMP_MEMOVERT];
+  unsigned long long key = 0;
+  int memo = (graph->numvert <= DECOMP_MEMOVERT);
+  int ret;
+
+  if (memo)
+  {
+    key = decomp_block_colour(graph, adj, col);
+    ret = decomp_memo_find(graph->numvert, key, adj, col, solution);
+    if (ret != HC_NOT_FOUND)
+    {
+      dstats->memohits++;
+      return(ret);
+    }
+  }
+
+  mark = arena_mark();
+  ret = master_backtrack_alg(graph, &blockstat, solution);
+  arena_release(mark);
+
+  dstats->numblocks++;
+  dstats->nodes += blockstat.nodes;
+  dstats->edgeprune += blockstat.edgeprune;
+  if (graph->numvert > dstats->maxblock)
+    dstats->maxblock = graph->numvert;
+
+  if ( (memo) && (ret != HC_NOT_FOUND) )
+    decomp_memo_store(graph->numvert, key, adj, col, ret, solution);
+
+  return(ret);
+
+}  /* end of decomp_solve_block() */
+
+
+/************************************************************/
+/* 3-vertex cut routines
+ */
+/************************************************************/
+
+/************************************************************/
+/* recursive search for a path from vertex v (local # of a gadget:  0-2
+ * the cut vertices, 3... the new ones) through all the vertices of
+ * mask, ending at vertex y.  returns 1 if found
+ */
+int
+decomp_gadget_path(
+  int adj[],
+  int v,
+  int y,
+  int mask)
+{
+  int bits;
+  int w;
+
+  if (mask == 0)
+    return( (adj[v] >> y) & 1 );
+
+  for (bits = adj[v] & mask; bits != 0; bits &= bits - 1)
+  {
+    w = __builtin_ctz(bits);
+    if (decomp_gadget_path(adj, w, y, mask & ~(1 << w)))
+      return(1);
+  }
+
+  return(0);
+
+}  /* end of decomp_gadget_path() */
+
+
+/************************************************************/
+/* this function returns the types (a bit for each) that the gadget is
+ * crossed by
+ */
+int
+decomp_gadget_types(
+  decomp_gadget_type *gadget)
+{
+  int newmask = ((1 << gadget->numnew) - 1) << 3;
+  int types = 0;
+  int third;
+  int t;
+
+  for (t = 0; t < DECOMP_NUMTYPES; t++)
+  {
+    third = TYPE_THIRD(t);
+    if (decomp_gadget_path(gadget->adj, (third + 1) % 3, (third + 2) % 3,
+	  newmask | (TYPE_IN(t) << third)))
+      types |= 1 << t;
+  }
+
+  return(types);
+
+}  /* end of decomp_gadget_types() */
+
+
+/************************************************************/
+/* this function looks for the gadget with the fewest new vertices (at
+ * most maxnew) that is crossed by exactly the types in the mask types.
+ * returns 1 if found (in gadget), 0 if not
+ */
+int
+decomp_find_gadget(
+  int types,
+  int maxnew,
+  decomp_gadget_type *gadget)
+{
+  int numnew;
+  int numbits;
+  int edges;
+  int bit;
+  int i, j;
+
+  for (numnew = 1; numnew <= maxnew; numnew++)
+  {
+    /* 3 bits for the cut vertices each new vertex is joined to, and a
+     * bit for each pair of new vertices
+     */
+    numbits = 3 * numnew + numnew * (numnew - 1) / 2;
+    gadget->numnew = numnew;
+
+    for (edges = 0; edges < (1 << numbits); edges++)
+    {
+      for (i = 0; i < 3 + numnew; i++)
+        gadget->adj[i] = 0;
+
+      bit = 0;
+      for (i = 3; i < 3 + numnew; i++)
+      {
+        for (j = 0; j < 3; j++, bit++)
+        {
+          if ((edges >> bit) & 1)
+          {
+            gadget->adj[i] |= 1 << j;
+            gadget->adj[j] |= 1 << i;
+          }
+        }
+        for (j = 3; j < i; j++, bit++)
+        {
+          if ((edges >> bit) & 1)
+          {
+            gadget->adj[i] |= 1 << j;
+            gadget->adj[j] |= 1 << i;
+          }
+        }
+      }
+
+      if (decomp_gadget_types(gadget) == types)
+        return(1);
+    }
+  }
+
+  return(0);
+
+}  /* end of decomp_find_gadget() */
+
+
+/************************************************************/
+/* this function solves the graph with side 1 of the 3-cut replaced by
+ * the gadget, and if it has a cycle, turns it into a cycle of the
+ * graph:  the gadget's path in it, from cut vertex x to cut vertex y,
+ * is replaced by the path through side 1 of the same type (spath[t],
+ * from cut[(third+1)%3] to cut[(third+2)%3]).
+ * returns HC_FOUND (with the cycle in solution[]), HC_NOT_EXIST or
+ * HC_NOT_FOUND
+ */
+int
+decomp_solve_gadget(
+  graph_type *graph,
+  decomp_split_type *split,
+  int side[],
+  decomp_gadget_type *gadget,
+  int *spath[],
+  int slen[],
+  int solution[],
+  decomp_stats_type *dstats)
+{
+  graph_type *reduced = ARENA_NEW(graph_type);
+  int *map = ARENA_ARRAY(int, graph->numvert + DECOMP_MAXGADGET);
+  int *redsol = ARENA_ARRAY(int, graph->numvert + DECOMP_MAXGADGET);
+  int *newid = ARENA_ARRAY(int, graph->numvert);
+  int numvert = 0;
+  int numred;
+  int loop, eloop;
+  int i, j;
+  int pos, dir = 1;
+  int x, y, third, in;
+  int t;
+  int len;
+  int v, w;
+  int ret;
+
+#define INGADGET(p) (map[redsol[((p) + numred) % numred]] < 0)
+
+  for (loop = 0; loop < graph->numvert; loop++)
+  {
+    if (side[loop] != 1)
+    {
+      newid[loop] = numvert;
+      map[numvert++] = loop;
+    }
+    else
+      newid[loop] = -1;
+  }
+
+  init_graph(reduced);
+  numred = reduced->numvert = numvert + gadget->numnew;
+  for (i = 0; i < gadget->numnew; i++)
+    map[numvert + i] = -1;
+
+  for (loop = 0; loop < graph->numvert; loop++)
+  {
+    if (newid[loop] == -1)
+      continue;
+
+    for (eloop = 0; eloop < graph->deg[loop]; eloop++)
+    {
+      w = graph->nbr[loop][eloop];
+      if (newid[w] != -1)
+        add_direct_edge_graph(reduced, newid[loop], newid[w]);
+    }
+  }
+
+  for (i = 3; i < 3 + gadget->numnew; i++)
+  {
+    for (j = 0; j < i; j++)
+    {
+      if ((gadget->adj[i] >> j) & 1)
+        add_edge_graph(reduced, numvert + i - 3,
+		(j < 3) ? newid[split->cut[j]] : numvert + j - 3);
+    }
+  }
+
+  ret = decomp_solve(reduced, redsol, dstats);
+  if (ret != HC_FOUND)
+    return(ret);
+
+  /* an end of the gadget's path:  a cut vertex with a gadget vertex on
+   * one side of it in the cycle, and not on the other
+   */
+  for (pos = 0; pos < numred; pos++)
+  {
+    if ( (map[redsol[pos]] < 0) || (side[map[redsol[pos]]] != 0) )
+      continue;
+    if ( (INGADGET(pos + 1)) && (!INGADGET(pos - 1)) )
+    {
+      dir = 1;
+      break;
+    }
+    if ( (INGADGET(pos - 1)) && (!INGADGET(pos + 1)) )
+    {
+      dir = -1;
+      break;
+    }
+  }
+
+  /* walk the path to its other end, a cut vertex not followed by a
+   * gadget vertex (cut vertices followed by one are inside the path)
+   */
+  x = map[redsol[pos]];
+  in = 0;
+  for (loop = 1; ; loop++)
+  {
+    i = (pos + dir * loop + numred) % numred;
+    if (map[redsol[i]] < 0)
+      continue;
+    if (!INGADGET(i + dir))
+      break;
+    in = 1;
+  }
+  y = map[redsol[i]];
+
+  for (third = 0; (split->cut[third] == x) || (split->cut[third] == y);
+	third++)
+    ;
+  t = 2 * third + in;
+
+  /* the path through side 1, from x to y */
+  len = 0;
+  if (spath[t][0] == x)
+  {
+    for (loop = 0; loop < slen[t]; loop++)
+      solution[len++] = spath[t][loop];
+  }
+  else
+  {
+    for (loop = slen[t] - 1; loop >= 0; loop--)
+      solution[len++] = spath[t][loop];
+  }
+
+  /* then the rest of the cycle, from after y back to before x */
+  for (loop = 1; ; loop++)
+  {
+    v = (i + dir * loop + numred) % numred;
+    if (v == pos)
+      break;
+    solution[len++] = map[redsol[v]];
+  }
+
+#undef INGADGET
+
+  return(HC_FOUND);
+
+}  /* end of decomp_solve_gadget() */
+
+
+/************************************************************/
+/* this function solves the graph at a 3-vertex cut:  side 1 (the side
+ * of split->c) is solved for each type, then replaced by a gadget with
+ * the same types (or, if there is none, by a gadget for each of its
+ * types in turn).
+ * returns HC_FOUND (with the cycle in solution[]), HC_NOT_EXIST or
+ * HC_NOT_FOUND
+ */
+int
+decomp_solve_cut3(
+  graph_type *graph,
+  decomp_split_type *split,
+  int solution[],
+  decomp_stats_type *dstats)
+{
+  decomp_gadget_type gadget;
+  graph_type *piece;
+  int *side = ARENA_ARRAY(int, graph->numvert);
+  int *spath[DECOMP_NUMTYPES];
+  int slen[DECOMP_NUMTYPES];
+  int *map, *piecesol;
+  int types = 0;
+  int maxnew;
+  int third;
+  int t;
+  int ret = HC_NOT_EXIST;
+  arena_mark_type mark;
+
+  decomp_label_sides(graph, split, side);
+
+  for (t = 0; t < DECOMP_NUMTYPES; t++)
+    spath[t] = ARENA_ARRAY(int, graph->numvert);
+
+  /* solve side 1 for each type */
+  mark = arena_mark();
+  piece = ARENA_NEW(graph_type);
+  map = ARENA_ARRAY(int, graph->numvert + 1);
+  piecesol = ARENA_ARRAY(int, graph->numvert + 1);
+  for (t = 0; t < DECOMP_NUMTYPES; t++)
+  {
+    third = TYPE_THIRD(t);
+    decomp_make_piece(graph, side, 1, split->cut[(third + 1) % 3],
+	split->cut[(third + 2) % 3], TYPE_IN(t) ? split->cut[third] : -1,
+	piece, map);
+    ret = decomp_solve(piece, piecesol, dstats);
+    if (ret == HC_NOT_FOUND)
+    {
+      arena_release(mark);
+      return(HC_NOT_FOUND);
+    }
+    if (ret == HC_FOUND)
+    {
+      types |= 1 << t;
+      slen[t] = decomp_piece_path(piecesol, piece->numvert, map,
+		split->cut[(third + 1) % 3], spath[t]);
+    }
+  }
+  arena_release(mark);
+
+  if (types == 0)
+    return(HC_NOT_EXIST);
+
+  /* the gadget must be smaller than the side, so the graph shrinks */
+  maxnew = split->minside - 1;
+  if (maxnew > DECOMP_MAXGADGET)
+    maxnew = DECOMP_MAXGADGET;
+
+  if (decomp_find_gadget(types, maxnew, &gadget))
+    return(decomp_solve_gadget(graph, split, side, &gadget, spath, slen,
+		solution, dstats));
+
+  /* no gadget has the same types, so try them one at a time */
+  dstats->numbranch++;
+  for (t = 0; t < DECOMP_NUMTYPES; t++)
+  {
+    if (!((types >> t) & 1))
+      continue;
+
+    decomp_find_gadget(1 << t, 2, &gadget);
+    ret = decomp_solve_gadget(graph, split, side, &gadget, spath, slen,
+		solution, dstats);
+    if (ret != HC_NOT_EXIST)
+      break;
+  }
+
+  return(ret);
+
+}  /* end of decomp_solve_cut3() */
+
+
+/************************************************************/
+/* this function solves the graph (which it changes by pruning) by
+ * splitting it at a 2-vertex cut and solving the 2 pieces, or at a
+ * 3-vertex cut, or as a block if there is no cut.  returns HC_FOUND
+ * (with the cycle in solution[]), HC_NOT_EXIST or HC_NOT_FOUND (time
+ * limit)
+ */
+int
+decomp_solve(
+  graph_type *graph,
+  int solution[],
+  decomp_stats_type *dstats)
+{
+  decomp_split_type split;
+  graph_type *piece;
+  int *side, *map, *piecesol, *path;
+  int numvert = graph->numvert;
+  int len1, len2;
+  int loop;
+  int prune = 0;
+  int ret;
+  arena_mark_type mark;
+
+  PHASE_START(PHASE_INITPRUNE);
+  ret = hc_do_pruning(graph, &prune, HC_PRUNE_ALL, NULL);
+  PHASE_STOP(PHASE_INITPRUNE);
+  dstats->edgeprune += prune;
+
+  if (ret == HC_NOT_EXIST)
+    return(HC_NOT_EXIST);
+
+  if (numvert < DECOMP_MINSPLIT)
+    return(decomp_solve_block(graph, solution, dstats));
+
+  mark = arena_mark();
+
+  PHASE_START(PHASE_CHECK);
+  ret = decomp_find_split(graph, &split);
+  if ( (ret == SPLIT_NONE) && (numvert <= DECOMP_MAX3CUT) )
+    ret = decomp_find_split3(graph, &split);
+  PHASE_STOP(PHASE_CHECK);
+
+  if (ret != SPLIT_FOUND)
+  {
+    arena_release(mark);
+    if (ret == SPLIT_NOHC)
+      return(HC_NOT_EXIST);
+    return(decomp_solve_block(graph, solution, dstats));
+  }
+
+  if (split.numcut == 3)
+  {
+    dstats->numsplits3++;
+    ret = decomp_solve_cut3(graph, &split, solution, dstats);
+    arena_release(mark);
+    return(ret);
+  }
+  dstats->numsplits++;
+
+  /* side 1 is the part of graph - {a,b} reached from c, side 2 the rest */
+  side = ARENA_ARRAY(int, numvert);
+  decomp_label_sides(graph, &split, side);
+
+  piece = ARENA_NEW(graph_type);
+  map = ARENA_ARRAY(int, numvert + 1);
+  piecesol = ARENA_ARRAY(int, numvert + 1);
+  path = ARENA_ARRAY(int, numvert + 1);
+
+  /* a to b through side 1, straight into solution[] */
+  decomp_make_piece(graph, side, 1, split.cut[0], split.cut[1], -1, piece,
+	map);
+  ret = decomp_solve(piece, piecesol, dstats);
+  if (ret == HC_FOUND)
+  {
+    len1 = decomp_piece_path(piecesol, piece->numvert, map, split.cut[0],
+	solution);
+
+    /* b to a through side 2, then leave out its ends */
+    decomp_make_piece(graph, side, 2, split.cut[0], split.cut[1], -1, piece,
+	map);
+    ret = decomp_solve(piece, piecesol, dstats);
+    if (ret == HC_FOUND)
+    {
+      len2 = decomp_piece_path(piecesol, piece->numvert, map, split.cut[1],
+	path);
+      for (loop = 1; loop < len2 - 1; loop++)
+        solution[len1++] = path[loop];
+    }
+  }
+
+  arena_release(mark);
+
+  return(ret);
+
+}  /* end of decomp_solve() */
+
+
+/************************************************************/
+/* main body of the decomposition solver
+ *   returns HC_FOUND if HC found (solution is the ordering of the
+ *   vertices in the cycle), HC_NOT_EXIST if a cycle cannot exist, and
+ *   HC_NOT_FOUND if the time limit was reached
+ */
+int
+master_decomp_alg(
+  graph_type *graph,
+  stat_pertrial_type *trialstats,
+  int solution[])
+{
+  graph_type *testgraph = ARENA_NEW(graph_type);
+  decomp_stats_type dstats;
+  int alg = g_options.algorithm;
+  int flags = g_options.report_flags;
+  int ret;
+
+  memset(&dstats, 0, sizeof(dstats));
+
+  /* the memo only holds blocks of this trial */
+  g_blockmemo.entry = ARENA_ARRAY(decomp_memo_entry_type, DECOMP_MEMOSIZE);
+  g_blockmemo.numentry = 0;
+  g_blockmemo.next = 0;
+
+  PHASE_START(PHASE_COPY);
+  copy_graph(graph, testgraph);
+  PHASE_STOP(PHASE_COPY);
+
+  /* the blocks are solved by the pruning backtrack algorithm, without
+   * its per-search reports
+   */
+  g_options.algorithm = ALG_BACKTRACK;
+  g_options.report_flags &= ~REPORT_ALG;
+
+  ret = decomp_solve(testgraph, solution, &dstats);
+
+  g_options.algorithm = alg;
+  g_options.report_flags = flags;
+
+  /* update statistics */
+  trialstats->nodes = dstats.nodes;
+  trialstats->edgeprune = dstats.edgeprune;
+  trialstats->initprune = 0;
+  trialstats->retries = dstats.numblocks;
+
+  if (g_options.report_flags & REPORT_ALG)
+  {
+    fprintf(g_options.log_fp, "Split at %d 2-vertex and %d 3-vertex cuts "
+	"(%d tried type by type), solved %d blocks (largest %d vertices), "
+	"%d more found in the block memo.\n", dstats.numsplits,
+	dstats.numsplits3, dstats.numbranch, dstats.numblocks,
+	dstats.maxblock, dstats.memohits);
+  }
+
+  return(ret);
+
+}  /* end of master_decomp_alg() */
@@ -0,0 +1,131 @@
+
+
+#ifndef _DECOMP_H_
+#define _DECOMP_H_
+
+
+/************************************************************/
+/* defines and data structures */
+/************************************************************/
+
+/* graphs smaller than this are solved without looking for a split */
+#define DECOMP_MINSPLIT		12
+
+/* a split must leave at least this many vertices on each side (with 1
+ * vertex on a side, the other piece is as big as the graph)
+ */
+#define DECOMP_MINSIDE		2
+
+/* 3-vertex cuts are only looked for when there is no 2-vertex cut, in
+ * graphs of up to this many vertices (it takes a dfs for each pair of
+ * vertices)
+ */
+#define DECOMP_MAX3CUT		200
+
+/* the side of a 3-vertex cut that is solved for each way of crossing
+ * it must have at least this many vertices, as must the other side
+ */
+#define DECOMP_MINSIDE3		3
+
+/* traversal types of a 3-vertex cut {cut[0],cut[1],cut[2]}:  a cycle
+ * crosses each side of the cut as one path between two of the cut
+ * vertices, with the third one inside that path or not.  type t has
+ * the third vertex cut[TYPE_THIRD(t)], inside the path if TYPE_IN(t).
+ * the other side is then crossed by type t^1
+ */
+#define DECOMP_NUMTYPES		6
+#define TYPE_THIRD(t)		((t) >> 1)
+#define TYPE_IN(t)		((t) & 1)
+
+/* the most new vertices in the small graph put in place of a side of a
+ * 3-vertex cut (a gadget, crossed by the same types as the side)
+ */
+#define DECOMP_MAXGADGET	3
+
+/* blocks of up to this many vertices are kept in the block memo (their
+ * adjacency is kept as a bit mask per vertex), and the # of blocks kept
+ */
+#define DECOMP_MEMOVERT		64
+#define DECOMP_MEMOSIZE		256
+
+/* most steps of the search matching a block with a memoised one */
+#define DECOMP_ISOSTEPS		100000
+
+/* return values of decomp_find_split() */
+#define SPLIT_FOUND	0
+#define SPLIT_NONE	1
+#define SPLIT_NOHC	2	/* a cut vertex, so no hamiltonian cycle */
+
+/* state of the dfs for the cut vertices of the graph without 1 or 2
+ * vertices
+ */
+typedef struct {
+  int disc[MAXVERT];	/* discovery time (0 = not visited yet) */
+  int low[MAXVERT];
+  int size[MAXVERT];	/* # of vertices in the dfs subtree */
+  int parent[MAXVERT];
+  char out[MAXVERT];	/* 1 for the vertices left out of the graph */
+  int cut[2];		/* the vertices left out */
+  int numout;
+  int time;
+  int root;
+  }  decomp_dfs_type;
+
+/* a 2 or 3-vertex cut of a graph, and a vertex c on one side of it */
+typedef struct {
+  int cut[3];
+  int numcut;
+  int c;
+  int minside;		/* 2-cuts:  # of vertices on the smaller side.
+			 * 3-cuts:  # of vertices on the side of c */
+  }  decomp_split_type;
+
+/* a gadget:  adjacency (bit masks) of its new vertices 3, 4, ... with
+ * each other and with the cut vertices 0, 1, 2
+ */
+typedef struct {
+  int numnew;
+  int adj[3 + DECOMP_MAXGADGET];
+  }  decomp_gadget_type;
+
+/* a solved block kept in the block memo */
+typedef struct {
+  unsigned long long key;	/* from the refined vertex colours */
+  int numvert;
+  int ret;			/* HC_FOUND or HC_NOT_EXIST */
+  unsigned long long adj[DECOMP_MEMOVERT];
+  unsigned long long col[DECOMP_MEMOVERT];
+  int solution[DECOMP_MEMOVERT];
+  }  decomp_memo_entry_type;
+
+typedef struct {
+  decomp_memo_entry_type *entry;
+  int numentry;
+  int next;			/* entry to replace when full */
+  }  decomp_memo_type;
+
+/* totals over the blocks solved by the backtrack algorithm */
+typedef struct {
+  int numblocks;	/* # of blocks solved */
+  int numsplits;	/* # of 2-vertex cuts split at */
+  int numsplits3;	/* # of 3-vertex cuts split at */
+  int numbranch;	/* 3-cuts with no gadget, solved for each type */
+  int memohits;		/* # of blocks found in the block memo */
+  int maxblock;		/* # of vertices of the largest block */
+  int nodes;
+  int edgeprune;
+  }  decomp_stats_type;
+
+
+/************************************************************/
+/* function declarations */
+/************************************************************/
+
+int master_decomp_alg( graph_type *graph, stat_pertrial_type *trialstats,
+	int solution[]);
+
+int decomp_solve( graph_type *graph, int solution[],
+	decomp_stats_type *dstats);
+
+#endif /* _DECOMP_H_ */
+
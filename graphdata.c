@@ -345,8 +345,10 @@ init_graph(
 
 /************************************************************/
 /* this function copys a graph into a second graph.
- * (the second graph is initialized first)
  * graph is copied from source into dest
+ * only the live part of the neighbour lists is copied (the rest of
+ * dest->nbr[][] is left as it was), the degrees of the unused vertices
+ * are set to 0
  */
 void 
 copy_graph(
@@ -355,9 +357,6 @@ copy_graph(
 {
   int loop, dloop;
 
-  /* initialize destination graph */
-  init_graph(dest);
-
   /* degree and neighbour information */
   dest->numvert = source->numvert;
   for (loop = 0; loop < source->numvert; loop++)
@@ -367,6 +366,8 @@ copy_graph(
     for (dloop = 0; dloop < source->deg[loop]; dloop++)
       dest->nbr[loop][dloop] = source->nbr[loop][dloop];
   }
+  for ( ; loop < MAXVERT; loop++)
+    dest->deg[loop] = 0;
 
   /* copy statistics information */
   dest->numedges = source->numedges;
@@ -518,6 +519,33 @@ check_if_edge(
 }  /* end of check_if_edge() */
 
 
+/************************************************************/
+/* builds the adjacency bit matrix of the specified graph, so that 
+ * edges can be checked in constant time with CHECK_ADJMATRIX()
+ * (rather than the linear scan of check_if_edge())
+ * note that the matrix is not updated if the graph is later changed
+ */
+void
+calc_graph_adjmatrix(
+  graph_type *graph,
+  adjmatrix_type *adj)
+{
+  int loop, eloop;
+
+  adj->numvert = graph->numvert;
+
+  for (loop = 0; loop < graph->numvert; loop++)
+  {
+    for (eloop = 0; eloop < VSET_WORDS; eloop++)
+      adj->row[loop][eloop] = 0;
+
+    for (eloop = 0; eloop < graph->deg[loop]; eloop++)
+      VSET_ADD(adj->row[loop], graph->nbr[loop][eloop]);
+  }
+
+}  /* end of calc_graph_adjmatrix() */
+
+
 /************************************************************/
 /* depth-first-search for component checking
  * this function recursively labels vertex 'v' and all its neighbours
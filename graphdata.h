@@ -38,6 +38,27 @@ typedef struct {
   } graph_type;
 
 
+/* adjacency bit matrix:  row v has bit w set if edge v -> w exists.
+ * each row is stored as 64-bit words so that it can also be used 
+ * directly as a set of vertices (see VSET_* macros below).
+ * gives constant time edge checking, at the cost of MAXVERT^2 bits.
+ */
+#define VSET_WORDS ((MAXVERT+63)/64)
+
+typedef unsigned long long vset_type[VSET_WORDS];
+
+typedef struct {
+  int numvert;			/* number of vertices */
+  vset_type row[MAXVERT];	/* adjacency bits of each vertex */
+  } adjmatrix_type;
+
+/* vertex set / adjacency bit macros */
+#define VSET_TEST(set,v)  ( ((set)[(v)>>6] >> ((v)&63)) & 1ULL )
+#define VSET_ADD(set,v)   ( (set)[(v)>>6] |= (1ULL << ((v)&63)) )
+#define VSET_DEL(set,v)   ( (set)[(v)>>6] &= ~(1ULL << ((v)&63)) )
+
+#define CHECK_ADJMATRIX(adj,x,y)  VSET_TEST((adj)->row[x],y)
+
 /* graph file information */
 #define GFILE_EXT ".graph"
 #define GFILE_COMMENT "#"
@@ -77,6 +98,8 @@ int rm_edge_graph( graph_type *graph, int x, int y);
 
 int check_if_edge( graph_type *graph, int x, int y);
 
+void calc_graph_adjmatrix( graph_type *graph, adjmatrix_type *adj);
+
 int calc_graph_components( graph_type *graph);
 
 int check_graph_cutpoints( graph_type *graph);
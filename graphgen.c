@@ -34,55 +34,87 @@ random_order_list(
 /* this function randomly permutes a graph (scrambles the vertices)
  * assumes graph is properly set up
  * assumes graph is undirected
+ *
+ * the graph is relabelled in place:  the neighbours are renamed in one
+ * pass, then the rows are moved along the cycles of the permutation,
+ * through the inverse permutation, so only one row is held aside.  the
+ * neighbour lists are sorted if +sortnbrs is set
  */
 void
 random_permute_graph(
   graph_type *graph)
 {
-  graph_type new_graph;
-
   int vloop;
   int eloop;
-  int new_vertices[MAXVERT];
-  int new_first;
-  int new_second;
+  int new_vertices[MAXVERT];	/* new label of each vertex */
+  int old_vertices[MAXVERT];	/* inverse:  old vertex of each label */
+  char moved[MAXVERT];
+  int tempnbr[MAXDEGREE];
+  int tempdeg;
+  int dest, src;
+  int val;
 
-  /* copy old graph into new to preserve other information like # of vertices */
-  copy_graph(graph, &new_graph);
-
-  /* initialize the new graph's vertex and edge data */
-  for (vloop = 0; vloop < new_graph.numvert; vloop++)
-  {
-    for (eloop = 0; eloop < new_graph.deg[vloop]; eloop++)
-    {
-      new_graph.nbr[vloop][eloop] = 0;
-    }
-    new_graph.deg[vloop] = 0;
-  }
-  
   /* create the new vertex ordering */
-  for (vloop = 0; vloop < new_graph.numvert; vloop++)
+  for (vloop = 0; vloop < graph->numvert; vloop++)
   {
     new_vertices[vloop] = vloop;
   }
-  random_order_list(new_vertices, new_graph.numvert);
+  random_order_list(new_vertices, graph->numvert);
 
-  /* for each edge in the old graph, add the equivalent edge in the new graph */
   for (vloop = 0; vloop < graph->numvert; vloop++)
   {
-    new_first = new_vertices[vloop]; 
+    old_vertices[new_vertices[vloop]] = vloop;
+    moved[vloop] = 0;
+  }
+
+  /* rename the neighbours */
+  for (vloop = 0; vloop < graph->numvert; vloop++)
+  {
     for (eloop = 0; eloop < graph->deg[vloop]; eloop++)
+      graph->nbr[vloop][eloop] = new_vertices[graph->nbr[vloop][eloop]];
+  }
+
+  /* move each row to its new label, one cycle of the permutation at a
+   * time:  row dest is set aside, then filled from old_vertices[dest],
+   * which is filled in turn, until the cycle comes back to the start
+   */
+  for (vloop = 0; vloop < graph->numvert; vloop++)
+  {
+    if ( (moved[vloop]) || (old_vertices[vloop] == vloop) )
+      continue;
+
+    tempdeg = graph->deg[vloop];
+    memcpy(tempnbr, graph->nbr[vloop], tempdeg * sizeof(int));
+
+    dest = vloop;
+    src = old_vertices[dest];
+    while (src != vloop)
     {
-      new_second = new_vertices[graph->nbr[vloop][eloop]];
-      if (check_if_edge(&new_graph, new_first, new_second) == EDGE_NOTEXIST)
+      graph->deg[dest] = graph->deg[src];
+      memcpy(graph->nbr[dest], graph->nbr[src], graph->deg[src] * sizeof(int));
+      moved[dest] = 1;
+      dest = src;
+      src = old_vertices[dest];
+    }
+    graph->deg[dest] = tempdeg;
+    memcpy(graph->nbr[dest], tempnbr, tempdeg * sizeof(int));
+    moved[dest] = 1;
+  }
+
+  /* insertion sort of each neighbour list (short lists) */
+  if (g_options.graphgen.sortnbrs)
+  {
+    for (vloop = 0; vloop < graph->numvert; vloop++)
+    {
+      for (eloop = 1; eloop < graph->deg[vloop]; eloop++)
       {
-        add_edge_graph(&new_graph, new_first, new_second);
+        val = graph->nbr[vloop][eloop];
+        for (src = eloop; (src > 0) && (graph->nbr[vloop][src-1] > val); src--)
+          graph->nbr[vloop][src] = graph->nbr[vloop][src-1];
+        graph->nbr[vloop][src] = val;
       }
-    }  /* end of loop through neighbours of current vertex */
-  }  /* end of loop through vertices */
-
-  /* copy new graph back into old */
-  copy_graph(&new_graph, graph);
+    }
+  }
 
 }  /* end of random_permute_graph() */
 
@@ -474,6 +506,66 @@ add_cycles_to_graph(
 }  /* end of add_cycles_to_graph() */
 
 
+/************************************************************/
+/* this function plants a random hamiltonian cycle in the graph, keeping
+ * the degree of every vertex (and so the degree distribution of the
+ * generator) where it can.  the cycle is a random permutation, as in
+ * add_cycles_to_graph(), but each missing cycle edge (a,b) is swapped in:
+ * edges (a,c) and (b,d) that are not on the cycle are replaced by (a,b)
+ * and (c,d).  if no such pair is found (e.g. a vertex of degree < 2),
+ * (a,b) is just added, raising the degree of a and b by one
+ */
+void
+plant_ham_cycle(
+  graph_type *graph)
+{
+  int numvert = graph->numvert;
+  int cycle[MAXVERT];
+  int pos[MAXVERT];	/* position of each vertex in cycle[] */
+  int loop, tries;
+  int a, b, c, d;
+
+/* 1 if (x,y) is an edge of the planted cycle */
+#define ONCYCLE(x,y) ( (abs(pos[x] - pos[y]) == 1) || \
+			(abs(pos[x] - pos[y]) == numvert - 1) )
+
+  for (loop = 0; loop < numvert; loop++)
+    cycle[loop] = loop;
+  random_order_list(cycle, numvert);
+  for (loop = 0; loop < numvert; loop++)
+    pos[cycle[loop]] = loop;
+
+  for (loop = 0; loop < numvert; loop++)
+  {
+    a = cycle[loop];
+    b = cycle[(loop + 1) % numvert];
+    if (check_if_edge(graph, a, b) == EDGE_EXIST)
+      continue;
+
+    /* try to swap (a,b) in, it is added either way */
+    for (tries = 0; (tries < ENSURE_SWAP_TRIES) && (graph->deg[a] > 0) &&
+		(graph->deg[b] > 0); tries++)
+    {
+      c = graph->nbr[a][lrand48() % graph->deg[a]];
+      d = graph->nbr[b][lrand48() % graph->deg[b]];
+      if ( (c == d) || ONCYCLE(a, c) || ONCYCLE(b, d) ||
+	   (check_if_edge(graph, c, d) == EDGE_EXIST) )
+        continue;
+
+      rm_edge_graph(graph, a, c);
+      rm_edge_graph(graph, b, d);
+      add_edge_graph(graph, c, d);
+      break;
+    }
+
+    add_edge_graph(graph, a, b);
+  }
+
+#undef ONCYCLE
+
+}  /* end of plant_ham_cycle() */
+
+
 /************************************************************/
 /* this function generates an add-cycle graph with <nvertex> vertices
  * and <ncycle> cycles placed in the graph
@@ -628,47 +720,17 @@ gen_crossroads_graph(
 /* generalized knight's circuit graph generator */
 /************************************************************/
 
-/************************************************************/
-/* this function adds an edge from the source cell to the destination
- * cell if they lie within the board 
- *
- * assume 2-dimensional board, with a 2-dimension knights move
- *
- */
-void 
-add_knighttour_edge(
-  graph_type *graph,
-  int boardx, 
-  int boardy,
-  int sourcex,
-  int sourcey,
-  int destx,
-  int desty)
-{
-  int sourcevert, destvert;
-
-  /* check to see if source and destination cells lie within the board */
-  if ( (sourcex < 0) || (sourcex >= boardx) ||
-       (sourcey < 0) || (sourcey >= boardy) ||
-       (destx < 0) || (destx >= boardx) ||
-       (desty < 0) || (desty >= boardy) )
-    return;
-
-  sourcevert = sourcex + sourcey * boardx;  
-  destvert = destx + desty * boardx;
-  
-  /* create directed edge */
-  add_direct_edge_graph(graph, sourcevert, destvert);
-
-}  /* end of add_knighttour_edge() */
-    
-
 /************************************************************/
 /* this function is the interface function for generating and 
  * returning a knighttour graph 
  *
  * assume a 2-d board, with a 2-d knights move
  *
+ * cell (x,y) is vertex x + y * boardx.  the knight's moves are the same
+ * from every cell, so the neighbours of each cell are written straight
+ * into its row:  its degree is the # of moves that stay on the board,
+ * and no edge has to be checked for or added twice.  moves that are the
+ * same (move1 = move2, or a move of 0) are only counted once
  */
 void 
 gen_knighttour_graph(
@@ -678,8 +740,12 @@ gen_knighttour_graph(
   int move1, 
   int move2)
 {
-  int loop;
+  int loop, mloop;
   int curx, cury;
+  int destx, desty;
+  int movex[8], movey[8];
+  int nummoves = 0;
+  int dx, dy;
 
   if (g_options.report_flags & REPORT_ALG)
   {
@@ -699,48 +765,50 @@ gen_knighttour_graph(
     EXIT_ERROR("knighttour graph generation exceeded max # of vertices.\n");
   }
 
-  /* loop through cells of board, add edges going away from current cell
-   * only, to avoid duplicate edges
-   */
-  curx = cury = 0;
-  
-  for (curx = -1, loop = 0; loop < graph->numvert; loop++)
+  /* the distinct moves, in the order the edges were always added */
+  for (loop = 0; loop < 8; loop++)
   {
-    /* increment board position */
-    curx ++;
-    if (curx >= boardx)
+    dx = (loop & 1) ? move2 : move1;
+    dy = (loop & 1) ? move1 : move2;
+    if (loop & 2)
+      dy = -dy;
+    if (loop & 4)
+      dx = -dx;
+
+    if ( (dx == 0) && (dy == 0) )
+      continue;
+    for (mloop = 0; mloop < nummoves; mloop++)
     {
-      curx = 0;
-      cury++;
+      if ( (movex[mloop] == dx) && (movey[mloop] == dy) )
+        break;
     }
+    if (mloop == nummoves)
+    {
+      movex[nummoves] = dx;
+      movey[nummoves] = dy;
+      nummoves++;
+    }
+  }
 
-    /* add edges based on where knight can move to from current cell 
-     * (don't worry about illegal moves)
-     */
-
-      add_knighttour_edge(graph, boardx, boardy, curx, cury, 
-	curx+move1, cury+move2);
-      add_knighttour_edge(graph, boardx, boardy, curx, cury, 
-	curx+move2, cury+move1);
-
-      add_knighttour_edge(graph, boardx, boardy, curx, cury, 
-	curx+move1, cury-move2);
-      add_knighttour_edge(graph, boardx, boardy, curx, cury, 
-	curx+move2, cury-move1);
-
-      add_knighttour_edge(graph, boardx, boardy, curx, cury, 
-	curx-move1, cury+move2);
-      add_knighttour_edge(graph, boardx, boardy, curx, cury, 
-	curx-move2, cury+move1);
-
-      add_knighttour_edge(graph, boardx, boardy, curx, cury, 
-	curx-move1, cury-move2);
-      add_knighttour_edge(graph, boardx, boardy, curx, cury, 
-	curx-move2, cury-move1);
-    
+  /* fill in the row of each cell */
+  for (loop = 0, cury = 0; cury < boardy; cury++)
+  {
+    for (curx = 0; curx < boardx; curx++, loop++)
+    {
+      for (mloop = 0; mloop < nummoves; mloop++)
+      {
+        destx = curx + movex[mloop];
+        desty = cury + movey[mloop];
+        if ( (destx >= 0) && (destx < boardx) && 
+	     (desty >= 0) && (desty < boardy) )
+          graph->nbr[loop][graph->deg[loop]++] = destx + desty * boardx;
+      }
+    }
   }  /* end of main loop through board positions */
 
-  random_permute_graph(graph);
+  /* keep the board layout (neighbouring cells have close numbers) */
+  if (!g_options.graphgen.nopermute)
+    random_permute_graph(graph);
 
 }  /* end of gen_knighttour_graph() */
 
@@ -768,6 +836,96 @@ stackswap(
 }  /* end of stackswap() */
 
 
+/************************************************************/
+/* which version of generate_fixed_degree_graph() to use:
+ *  1 - random edges, brute force completion over all remaining pairs
+ *  2 - random pairs from a vector of vertex copies
+ *  3 - random edges with fixups
+ *  4 - configuration model with double edge swap repair (see below)
+ * versions 1-3 return GEN_FAILURE when they get stuck, and the graph is
+ * generated again from scratch.  version 4 repairs the graph in place.
+ */
+#define DEGREEVERSION 4
+
+#if DEGREEVERSION == 4
+/************************************************************/
+/* edge set for the configuration model generator:  an open addressing
+ * hash table of edges (smaller endpoint first) with a count of the
+ * copies of each edge.  a slot whose count drops to 0 stays in the probe
+ * chains, and is reused by the next edge added along its chain.  lookups
+ * never add an edge, and the repair makes at most numedges swaps (2 new
+ * edges each), so fewer keys than the table's 4 * numedges slots are
+ * ever added, and a probe always ends at an empty slot
+ */
+typedef struct {
+  unsigned int *key;	/* edge key + 1 (0 = empty slot) */
+  int *count;		/* # of copies of the edge */
+  unsigned int mask;	/* table size - 1 */
+  } edgehash_type;
+
+#define EDGEKEY(v,w) ( ((v) < (w)) ? (unsigned int) ((v) * MAXVERT + (w)) \
+			: (unsigned int) ((w) * MAXVERT + (v)) )
+
+/************************************************************/
+/* this function returns the count of the specified edge key in the
+ * table (0 if it is not in the table)
+ */
+int
+edgehash_count(
+  edgehash_type *hash,
+  unsigned int key)
+{
+  unsigned int slot;
+
+  slot = (key * 2654435761u) & hash->mask;
+  while (hash->key[slot] != 0)
+  {
+    if (hash->key[slot] == key + 1)
+      return(hash->count[slot]);
+    slot = (slot + 1) & hash->mask;
+  }
+
+  return(0);
+
+}  /* end of edgehash_count() */
+
+
+/************************************************************/
+/* this function adds change (+1 or -1) to the count of the specified
+ * edge key.  an edge not in the table (only ever added to) goes in the
+ * first slot of its probe chain with a count of 0
+ */
+void
+edgehash_add(
+  edgehash_type *hash,
+  unsigned int key,
+  int change)
+{
+  unsigned int slot;
+  int freeslot = -1;
+
+  slot = (key * 2654435761u) & hash->mask;
+  while (hash->key[slot] != 0)
+  {
+    if (hash->key[slot] == key + 1)
+    {
+      hash->count[slot] += change;
+      return;
+    }
+    if ( (freeslot < 0) && (hash->count[slot] == 0) )
+      freeslot = slot;
+    slot = (slot + 1) & hash->mask;
+  }
+
+  if (freeslot >= 0)
+    slot = freeslot;
+  hash->key[slot] = key + 1;
+  hash->count[slot] = change;
+
+}  /* end of edgehash_add() */
+#endif  /* DEGREEVERSION 4 */
+
+
 /************************************************************/
 /* this function generates a random graph, with the degree of each
  * vertex set to the specified degreee (if possible)
@@ -790,7 +948,6 @@ generate_fixed_degree_graph(
   int maxdeg[])
 {
 
-#define DEGREEVERSION 1 
 #if DEGREEVERSION == 1
    /* array to hold the vertices which still have free valence */
    int vfreeval[MAXVERT];
@@ -808,6 +965,7 @@ generate_fixed_degree_graph(
 
    int numpairrem;
    struct vpair_struct *pairset;
+   arena_mark_type mark;
 
   int tempv,tempw;
   int v,w;
@@ -864,8 +1022,8 @@ generate_fixed_degree_graph(
    }
 
    /* complete the rest by setting up all possible pairs of remaining vertices */
-   pairset = (struct vpair_struct *) 
-	calloc(numpairrem*(numpairrem-1), sizeof(struct vpair_struct) ); 
+   mark = arena_mark();
+   pairset = ARENA_ARRAY(struct vpair_struct, numpairrem*(numpairrem-1));
 
    numpairrem = 0;
    for(v=0;v<numfreeval-1;v++)
@@ -904,7 +1062,7 @@ generate_fixed_degree_graph(
    }
 
 
-   free(pairset);
+   arena_release(mark);
    
 
    if (numfreeval > 0) 
@@ -940,6 +1098,7 @@ generate_fixed_degree_graph(
 	int n1,n2;
 
 	int *vvector;
+	arena_mark_type mark;
 
 	int numfails;
 
@@ -950,7 +1109,8 @@ generate_fixed_degree_graph(
 	for(i=0;i<numvert;i++)
 		totaldegree += maxdeg[i];
 	
-	vvector = (int *) calloc(totaldegree,sizeof(int));
+	mark = arena_mark();
+	vvector = ARENA_ARRAY(int, totaldegree);
 
 	k = 0;
 	for (i=0;i<numvert;i++) {
@@ -987,7 +1147,7 @@ generate_fixed_degree_graph(
 			numfails++;
 		if (numfails >= MAXFAILS)
 		{
-			free(vvector);
+			arena_release(mark);
 			/* fprintf(stderr,"FAILURE\n"); */
 			return GEN_FAILURE;
 		}
@@ -996,13 +1156,13 @@ generate_fixed_degree_graph(
 	w = vvector[1];
 	if ( (v==w) || ( EDGE_EXIST == check_if_edge(graph,v,w) ) )
 	{
-		free(vvector);
+		arena_release(mark);
 		/* fprintf(stderr,"FAILURE\n"); */
 		return GEN_FAILURE;
 	}
 		
 	add_edge_graph(graph,v,w);
-	free(vvector);
+	arena_release(mark);
 	/* fprintf(stderr,"OKAY\n"); */
 	return GEN_OKAY;
 }
@@ -1243,6 +1403,127 @@ generate_fixed_degree_graph(
 
 #endif /* DEGREEVERSION 3 */
 
+#if DEGREEVERSION == 4
+  /*
+	Configuration model:  each vertex v is put maxdeg[v] times into a
+	vector of edge endpoints, the vector is shuffled, and consecutive
+	pairs are made edges.  this gives the right degrees, but may give
+	loops and multiple edges.  these are repaired with double edge
+	swaps:  a bad edge (a,b) and a random edge (c,d) are replaced by
+	(a,c),(b,d) or (a,d),(b,c), if neither of those is a loop or an
+	edge already.  swaps keep all degrees, so the graph is never
+	regenerated, and the expected time is linear in the # of edges
+	(the # of bad edges only depends on the degrees).
+	returns GEN_FAILURE only if the repair does not finish (which
+	happens when the degree sequence has no graph at all).
+  */
+	int *endpoint;		/* edge i is endpoint[2i], endpoint[2i+1] */
+	int *badlist;		/* edges which may be loops or copies */
+	int numbad;
+	edgehash_type hash;
+
+	int numends, numedges;
+	int tablesize;
+	int i, j, k;
+	int a, b, c, d, temp;
+	int numswaps, numtries;
+	arena_mark_type mark;
+
+	for (numends = 0, i = 0; i < numvert; i++)
+		numends += maxdeg[i];
+	numedges = numends / 2;
+
+	mark = arena_mark();
+	endpoint = ARENA_ARRAY(int, numends + 1);
+	badlist = ARENA_ARRAY(int, numedges + 1);
+
+	for (tablesize = 16; tablesize < 4 * (numedges + 1); tablesize *= 2)
+		;
+	hash.mask = tablesize - 1;
+	hash.key = ARENA_ARRAY(unsigned int, tablesize);
+	hash.count = ARENA_ARRAY(int, tablesize);
+	memset(hash.key, 0, tablesize * sizeof(unsigned int));
+
+	/* random pairing of the endpoints */
+	for (k = 0, i = 0; i < numvert; i++)
+		for (j = 0; j < maxdeg[i]; j++)
+			endpoint[k++] = i;
+	random_order_list(endpoint, numends);
+
+	/* count the copies of each edge, and note the bad ones */
+	numbad = 0;
+	for (i = 0; i < numedges; i++)
+	{
+		a = endpoint[2*i];
+		b = endpoint[2*i+1];
+		edgehash_add(&hash, EDGEKEY(a,b), 1);
+		if ( (a == b) || (edgehash_count(&hash, EDGEKEY(a,b)) > 1) )
+			badlist[numbad++] = i;
+	}
+
+	/* repair the bad edges.  an edge on the bad list may have become
+	 * good in the meantime (the other copy was swapped away)
+	 */
+	numswaps = numtries = 0;
+	while (numbad > 0)
+	{
+		i = badlist[numbad-1];
+		a = endpoint[2*i];
+		b = endpoint[2*i+1];
+		if ( (a != b) && (edgehash_count(&hash, EDGEKEY(a,b)) <= 1) )
+		{
+			numbad--;
+			continue;
+		}
+
+		if ( (numswaps > numedges) || (numtries > 100 * numedges) )
+		{
+			arena_release(mark);
+			return(GEN_FAILURE);
+		}
+		numtries++;
+
+		/* random partner edge, in random orientation */
+		j = lrand48() % numedges;
+		if (j == i)
+			continue;
+		c = endpoint[2*j];
+		d = endpoint[2*j+1];
+		if (lrand48() % 2)
+		{
+			temp = c;  c = d;  d = temp;
+		}
+
+		/* new edges (a,c), (b,d) must be new and not loops */
+		if ( (a == c) || (b == d) || (EDGEKEY(a,c) == EDGEKEY(b,d)) )
+			continue;
+		if ( (edgehash_count(&hash, EDGEKEY(a,c)) > 0) ||
+		     (edgehash_count(&hash, EDGEKEY(b,d)) > 0) )
+			continue;
+
+		edgehash_add(&hash, EDGEKEY(a,b), -1);
+		edgehash_add(&hash, EDGEKEY(c,d), -1);
+		edgehash_add(&hash, EDGEKEY(a,c), 1);
+		edgehash_add(&hash, EDGEKEY(b,d), 1);
+		endpoint[2*i+1] = c;
+		endpoint[2*j] = b;
+		endpoint[2*j+1] = d;
+		numswaps++;
+		numbad--;
+	}
+
+  	init_graph(graph);
+  	graph->numvert = numvert;
+	for (i = 0; i < numedges; i++)
+		add_edge_graph(graph, endpoint[2*i], endpoint[2*i+1]);
+
+	arena_release(mark);
+	return(GEN_OKAY);
+
+}  /* end of generate_fixed_degree_graph() */
+
+#endif /* DEGREEVERSION 4 */
+
 /************************************************************/
 /* this function is the interface function for generating and 
  * returning a degreebound graph
@@ -1453,6 +1734,7 @@ gen_geo_graph(
   graph_type *graph)
 {
   double *vert;
+  arena_mark_type mark;
   int loop, eloop;
   double d2;
   double mindist = 0.0;
@@ -1467,11 +1749,8 @@ gen_geo_graph(
   }
 
   /* allocate memory for vertices of graph */
-  vert = (double *) malloc(sizeof(double)*dim*size);
-  if (vert == NULL)
-  {
-    EXIT_ERROR("Error allocating memory for vert[] array.\n");
-  }
+  mark = arena_mark();
+  vert = ARENA_ARRAY(double, dim*size);
 
   /* prepare graph data structure */
   init_graph(graph);
@@ -1551,9 +1830,230 @@ gen_geo_graph(
     }  /* end of for loop */
   }
 
+  arena_release(mark);
+
 }  /* end of gen_geo_graph() */
 
 
+/************************************************************/
+/* this function makes sure that a generated graph is hamiltonian, for
+ * +ensureham=fast.  posa is run for at most ENSURE_POSA_TIME seconds,
+ * then the backtrack algorithm for at most ENSURE_BT_NODES nodes per
+ * vertex.  if neither finds a cycle (or pruning shows that there isn't
+ * one), a cycle is planted in the graph instead of generating it again.
+ * returns ENSURED_POSA, ENSURED_BOUNDED or ENSURED_PLANTED
+ */
+int
+ensure_ham_fast(
+  graph_type *graph)
+{
+  int flags = g_options.report_flags;
+  int alg = g_options.algorithm;
+  long algtime = g_options.alg_timelimit;
+  backtrack_alg_options_type btoptions = g_options.bt_alg;
+  stat_pertrial_type trialstat;
+  int solution[MAXVERT];
+  int ret;
+  int ensured;
+  arena_mark_type mark;
+
+  g_options.report_flags = REPORT_NONE;
+  mark = arena_mark();
+
+  /* time-boxed posa run */
+  g_options.algorithm = ALG_POSA_HEUR;
+  g_options.alg_timelimit = ENSURE_POSA_TIME;
+  hc_start_timer();
+  ret = master_heuristic_alg(graph, &trialstat, solution);
+  ensured = ENSURED_POSA;
+
+  /* then a backtrack search with a node limit */
+  if (ret == HC_NOT_FOUND)
+  {
+    g_options.algorithm = ALG_BACKTRACK;
+    g_options.alg_timelimit = -1;
+    init_backtrack_alg_options();
+    g_options.bt_alg.degsortflag = DEGSORT_MIN;
+    g_options.bt_alg.pruneoptflag = HC_PRUNE_BASIC | HC_PRUNE_CYC;
+    g_options.bt_alg.max_nodes = ENSURE_BT_NODES * graph->numvert;
+
+    ret = master_backtrack_alg(graph, &trialstat, solution);
+    ensured = ENSURED_BOUNDED;
+  }
+
+  arena_release(mark);
+
+  /* restore flags */
+  g_options.report_flags = flags;
+  g_options.algorithm = alg;
+  g_options.alg_timelimit = algtime;
+  g_options.bt_alg = btoptions;
+
+  if (ret != HC_FOUND)
+  {
+    plant_ham_cycle(graph);
+    ensured = ENSURED_PLANTED;
+
+    if (flags & REPORT_ALG)
+    {
+      fprintf(g_options.log_fp,"  Planting a hamiltonian cycle (none found)...\n");
+    }
+  }
+
+  return(ensured);
+
+}  /* end of ensure_ham_fast() */
+
+
+/************************************************************/
+/* function to generate desired graph, using options
+ * note that graph statistics are also calculated
+ *
+ * returns how the graph was made sure to be hamiltonian (ENSURED_*),
+ * ENSURED_NONE if +ensureham isn't set
+ */
+int
+generate_graph(
+  graph_type *graph)
+{
+  int done = 0;
+  int ensured = ENSURED_NONE;
+  int flags;
+  int alg;
+  long algtime;
+  stat_pertrial_type trialstat;
+  int solution[MAXVERT];
+  int ret;
+  int num_edges;
+  arena_mark_type mark;
+
+  do   /* do-while loop for hamiltonicity */
+  {
+    switch(g_options.graphgentype)
+    {
+      case GEN_ICCS:
+        gen_iccs_graph( graph, g_options.graphgen.numsubgraphs,
+		g_options.graphgen.indsetsize);
+	break;
+
+      case GEN_ADDPATH:
+        gen_addpath_graph( graph, g_options.graphgen.nvertex,
+		2, g_options.graphgen.pathlengths);
+	break;
+
+      case GEN_ADDCYCLE:	
+        gen_addcycle_graph( graph, g_options.graphgen.nvertex,
+				g_options.graphgen.numcycles);
+	break;
+
+      case GEN_RANDOM:	
+	/* if degconst is specified, then calculate the mean degree */
+        if (g_options.graphgen.degconst > 0.0)
+        {
+          g_options.graphgen.meandeg = g_options.graphgen.degconst *
+		(float) (log( (double) g_options.graphgen.nvertex) +
+		 log(log( (double) g_options.graphgen.nvertex)));
+        }
+      
+        /* calculate the number of edges */
+        num_edges = (int) ( ( (float) g_options.graphgen.meandeg * 
+		g_options.graphgen.nvertex) / 2.0 );
+        gen_random_graph( graph, g_options.graphgen.nvertex, num_edges);
+        break;
+
+      case GEN_CROSSROADS:	
+        gen_crossroads_graph( graph, g_options.graphgen.numsubgraphs);
+        break;
+
+      case GEN_DEGREEBOUND:	
+        gen_degbound_graph( graph, g_options.graphgen.nvertex,
+  			g_options.graphgen.degsize,
+  			g_options.graphgen.degpercent);
+        break;
+  
+      case GEN_KNIGHTTOUR:	
+  
+        gen_knighttour_graph( graph, g_options.graphgen.board1,
+  			g_options.graphgen.board2,
+  			g_options.graphgen.move1,
+  			g_options.graphgen.move2);
+  
+        break;
+  
+      case GEN_GEOMETRIC:
+  
+        gen_geo_graph( 	g_options.graphgen.nvertex,
+  			g_options.graphgen.dist * g_options.graphgen.dist,
+  			g_options.graphgen.dflag, 
+  			g_options.graphgen.dim, 
+  			g_options.graphgen.wrapflag, graph);
+        break;
+  
+      default:
+        EXIT_ERROR("Error: invalid graph type in generate_graph().\n");
+        break;
+  
+    }  /* end of switch statement */
+
+    if (g_options.graphgen.makeham == HAM_DONTCARE)
+    {
+      done = 1;
+    }
+    else if (g_options.graphgen.makeham == HAM_FAST)
+    {
+      ensured = ensure_ham_fast(graph);
+      done = 1;
+    }
+    else /* need to confirm that cycle exists; use backtrack algorithm */
+    {
+      flags = g_options.report_flags;
+      alg = g_options.algorithm;
+      algtime = g_options.alg_timelimit;
+      g_options.report_flags = REPORT_NONE;
+      g_options.algorithm = ALG_BACKTRACK;
+      g_options.alg_timelimit = -1;	
+
+      trialstat.result = HC_NOT_FOUND;
+
+      /* set algorithm options */
+      g_options.bt_alg.initvertflag = INITVERT_RANDOM;
+      g_options.bt_alg.degsortflag = DEGSORT_MIN;
+      g_options.bt_alg.pruneoptflag = HC_PRUNE_BASIC | HC_PRUNE_CYC;
+
+      mark = arena_mark();
+      ret = master_backtrack_alg(graph, &trialstat, solution);
+      arena_release(mark);
+      
+      if (ret == HC_FOUND)
+      {
+        ensured = ENSURED_BACKTRACK;
+        done = 1;
+      }
+      else
+      {
+        if (flags & REPORT_ALG)
+        {
+        fprintf(g_options.log_fp,"  Regenerating graph (not hamiltonian)...\n");
+        }
+      }
+
+      /* restore flags */
+      g_options.report_flags = flags;
+      g_options.algorithm = alg;
+      g_options.alg_timelimit = algtime;
+
+    }  /* end of makeham code */
+
+  } while(!done);  /* hamiltonicity while loop */
+
+  /* graph is generated, so calculate graph statistics */
+  calc_graph_stats(graph);
+
+  return(ensured);
+
+}  /* end of generate_graph() */
+
+
 /************************************************************/
 /* this function parses the option file for parameters for generating 
  * a particular graph type
@@ -1617,7 +2117,14 @@ parse_graphgen_options(
       /* ensure hamiltonicity parameter */
       else if (strcasecmp(parmstr, "+ensureham") == 0)
       {
-        g_options.graphgen.makeham = HAM_ENSURE;
+        if (valstr[0] == '\0')
+          g_options.graphgen.makeham = HAM_ENSURE;
+        else if (strcasecmp(valstr, "fast") == 0)
+          g_options.graphgen.makeham = HAM_FAST;
+        else
+        {
+          EXIT_ERROR1("Error: invalid +ensureham value `%s'.\n", valstr);
+        }
         if (graphgentype == GEN_KNIGHTTOUR)
         {
           EXIT_ERROR("Warning: cannot ensure hamiltonicity of knight's tour graphs.\n");
@@ -1676,6 +2183,30 @@ parse_graphgen_options(
         }
       }
 
+      /* sorted neighbour lists flag */
+      else if (strcasecmp(parmstr, "+sortnbrs") == 0) 
+      {
+        g_options.graphgen.sortnbrs = 1;
+
+        if ( (graphgentype == GEN_GEOMETRIC) || (graphgentype == GEN_RANDOM) )
+        {
+          fprintf(stderr,"Warning:  `+sortnbrs' parameter not relevant for "
+                  "%s graph generation.\n", opt_gen_str[graphgentype]);
+        }
+      }
+
+      /* no permutation flag */
+      else if (strcasecmp(parmstr, "+nopermute") == 0) 
+      {
+        g_options.graphgen.nopermute = 1;
+
+        if (graphgentype != GEN_KNIGHTTOUR)
+        {
+          fprintf(stderr,"Warning:  `+nopermute' parameter not relevant for "
+                  "%s graph generation.\n", opt_gen_str[graphgentype]);
+        }
+      }
+
       /* near flag */
       else if (strcasecmp(parmstr, "+near") == 0) 
       {
@@ -1703,7 +2234,7 @@ parse_graphgen_options(
       /* wrap flag */
       else if (strcasecmp(parmstr, "+wrap") == 0) 
       {
-        g_options.graphgen.dflag = GRAPH_WRAP;
+        g_options.graphgen.wrapflag = GRAPH_WRAP;
 
         if (graphgentype != GEN_GEOMETRIC)
         {
@@ -1715,7 +2246,7 @@ parse_graphgen_options(
       /* no-wrap flag */
       else if (strcasecmp(parmstr, "+nowrap") == 0) 
       {
-        g_options.graphgen.dflag = GRAPH_NOWRAP;
+        g_options.graphgen.wrapflag = GRAPH_NOWRAP;
 
         if (graphgentype != GEN_GEOMETRIC)
         {
@@ -2037,6 +2568,8 @@ init_graphgen_options()
   g_options.graphgen.nvertex = 50;
 
   g_options.graphgen.makeham = HAM_DONTCARE;
+  g_options.graphgen.sortnbrs = 0;
+  g_options.graphgen.nopermute = 0;
 
   g_options.graphgen.dist = 0.255;
   g_options.graphgen.dim = 2;
@@ -2091,6 +2624,17 @@ print_graphgen_options(
     {
       fprintf(fp, "    ensure that graph is hamiltonian\n");
     }
+    else if (g_options.graphgen.makeham == HAM_FAST)
+    {
+      fprintf(fp, "    ensure that graph is hamiltonian (fast, may plant a cycle)\n");
+    }
+  }
+
+  if ( (g_options.graphgen.sortnbrs) && 
+	(g_options.graphgentype != GEN_GEOMETRIC) &&
+	(g_options.graphgentype != GEN_RANDOM) )
+  {
+    fprintf(fp, "    sort the neighbour lists\n");
   }
 
   /* ICCS graph */
@@ -2105,8 +2649,8 @@ print_graphgen_options(
   if (g_options.graphgentype == GEN_ADDPATH)
   {
     int loop = 0;
-    while ( (g_options.graphgen.pathlengths[loop] > 0.0) && 
-		(loop < MAXNUMADDPATHS) )
+    while ( (loop < MAXNUMADDPATHS) && 
+		(g_options.graphgen.pathlengths[loop] > 0.0) )
     {
       fprintf(fp, "    path length = %.2f\n",
 	g_options.graphgen.pathlengths[loop]);
@@ -2179,6 +2723,8 @@ print_graphgen_options(
 	g_options.graphgen.board1, g_options.graphgen.board2);
     fprintf(fp, "    knight movement = %d, %d\n", 
 	g_options.graphgen.move1, g_options.graphgen.move2);
+    if (g_options.graphgen.nopermute)
+      fprintf(fp, "    vertices not permuted (numbered by board cell)\n");
   }
   
   /* crossroads graph */
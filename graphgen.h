@@ -21,6 +21,21 @@
 
 #define HAM_DONTCARE 0
 #define HAM_ENSURE 1
+#define HAM_FAST 2	/* posa, bounded backtrack, then a planted cycle */
+
+/* how the generated graph was made sure to be hamiltonian
+ * (returned by generate_graph(), recorded per graph)
+ */
+#define ENSURED_NONE		0	/* not checked (HAM_DONTCARE) */
+#define ENSURED_BACKTRACK	1	/* backtrack search (HAM_ENSURE) */
+#define ENSURED_POSA		2	/* time-boxed posa run */
+#define ENSURED_BOUNDED		3	/* backtrack search with a node limit */
+#define ENSURED_PLANTED		4	/* a hamiltonian cycle was planted */
+
+/* limits of the HAM_FAST checks */
+#define ENSURE_POSA_TIME	1	/* seconds (user time) for posa */
+#define ENSURE_BT_NODES		1000	/* backtrack nodes per vertex */
+#define ENSURE_SWAP_TRIES	100	/* tries to swap in a planted edge */
 
 #define MAXNUMADDPATHS 2
 
@@ -31,7 +46,8 @@ typedef struct {
   /* common options */
   int nvertex;		/* number of vertices */
   int makeham;		/* make sure graph is hamilton */
-                        /* (HAM_ENSURE or HAM_DONTCARE */
+                        /* (HAM_ENSURE, HAM_FAST or HAM_DONTCARE) */
+  int sortnbrs;		/* = 1 to sort the neighbour lists of permuted graphs */
   
   /* geometric graph options */
   float dist;		/* distance */
@@ -49,6 +65,7 @@ typedef struct {
   int board2;
   int move1;
   int move2;
+  int nopermute;	/* = 1 to keep the board numbering of the cells */
 
   /* crossroads parameters */
   int numsubgraphs;
@@ -76,6 +93,8 @@ typedef struct {
 
 void add_cycles_to_graph( graph_type *graph, float ncycles);
 
+void plant_ham_cycle( graph_type *graph);
+
 void gen_iccs_graph( graph_type *graph, int subgraphs, int indsetsize);
 
 void gen_addpath_graph( graph_type *graph, int nvertex, int numpath,
@@ -99,6 +118,8 @@ void gen_degbound_graph( graph_type *graph, int numvert, int degsize,
 void gen_geo_graph( int size, double dist2, int dflag, int dim, int wrap,
         graph_type *graph);
 
+int generate_graph( graph_type *graph);
+
 int parse_graphgen_options( FILE *fp, char word[], int gengraphtype);
 
 void init_graphgen_options( );
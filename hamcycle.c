@@ -4,11 +4,101 @@
 
 #include "main.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HC_NBR_AVX2
+#include <immintrin.h>
+#endif
+
 /* local global variable: starting time of algorithm */
 
 struct timeval g_algstart;
 int g_hit_timelimit = RUN_NORMAL;
 
+/* why the last hc_do_pruning() returned HC_NOT_EXIST (CAUSE_*) */
+int g_prune_cause = CAUSE_DEGREE;
+
+
+/************************************************************/
+/* function to get the (user) time used by the program and its finished
+ * child processes (the count workers of +countworkers)
+ */
+void
+hc_get_cputime(
+  struct timeval *cputime)
+{
+  struct rusage selftime, childtime;
+
+  getrusage(RUSAGE_SELF,&selftime);
+  getrusage(RUSAGE_CHILDREN,&childtime);
+  timeradd(&selftime.ru_utime, &childtime.ru_utime, cputime);
+
+}  /* end of hc_get_cputime() */
+
+
+/************************************************************/
+/* function to return the (user) time in seconds that the current
+ * \hc\ algorithm has been running for
+ */
+float
+hc_get_elapsed_time()
+{
+  struct timeval curtime;
+  struct timeval nowtime;
+
+  hc_get_cputime(&curtime);
+  nowtime.tv_sec = curtime.tv_sec - g_algstart.tv_sec;
+  nowtime.tv_usec = curtime.tv_usec - g_algstart.tv_usec;
+
+  return(nowtime.tv_sec + ( (float) nowtime.tv_usec / 1000000.0));
+
+}  /* end of hc_get_elapsed_time() */
+
+
+/************************************************************/
+/* function to start the timer of a \hc\ algorithm (and clear the time
+ * limit flag).  called for each trial, and for the checks of 
+ * +ensureham=fast
+ */
+void
+hc_start_timer()
+{
+  g_hit_timelimit = RUN_NORMAL;
+  hc_get_cputime(&g_algstart);
+
+}  /* end of hc_start_timer() */
+
+
+/************************************************************/
+/* function to carry on the timer of a \hc\ algorithm in a forked child
+ * process (whose own time starts again at 0), from the time used seconds
+ * that the algorithm had been running for when it was forked
+ */
+void
+hc_fork_timer(
+  float used)
+{
+  struct timeval curtime;
+  struct timeval usedtime;
+
+  hc_get_cputime(&curtime);
+  usedtime.tv_sec = (long) used;
+  usedtime.tv_usec = (long) ((used - usedtime.tv_sec) * 1000000.0);
+  timersub(&curtime, &usedtime, &g_algstart);
+
+}  /* end of hc_fork_timer() */
+
+
+/************************************************************/
+/* function to record that the time limit was reached, by an algorithm
+ * that ran in child processes
+ */
+void
+hc_set_timelimit_hit()
+{
+  g_hit_timelimit = RUN_TIMELIMIT;
+
+}  /* end of hc_set_timelimit_hit() */
+
 
 /************************************************************/
 /* function to check the time limit for a \hc\ algorithm 
@@ -18,23 +108,12 @@ int g_hit_timelimit = RUN_NORMAL;
 int
 hc_check_timelimit()
 {
-  long timeret;
-  struct rusage curtime;
-  struct timeval nowtime;
-  float difftime;
-
   /* make sure time limit is being used */
   if (g_options.alg_timelimit < 0)
     return(HC_CONTINUE);
 
-  /* calculate current time */
-  timeret = getrusage(RUSAGE_SELF,&curtime);
-  nowtime.tv_sec = curtime.ru_utime.tv_sec - g_algstart.tv_sec;
-  nowtime.tv_usec = curtime.ru_utime.tv_usec - g_algstart.tv_usec;
-  difftime = nowtime.tv_sec + ( (float) nowtime.tv_usec / 1000000.0);
-
   /* check if difference is more than time limit */
-  if (difftime >= g_options.alg_timelimit)
+  if (hc_get_elapsed_time() >= g_options.alg_timelimit)
   {
     g_hit_timelimit = RUN_TIMELIMIT;
     return(HC_QUIT);
@@ -177,6 +256,28 @@ copy_edgestack(
 }  /* end of copy_edgestack() */
 
 
+/************************************************************/
+/* function to undo the edge deletions recorded on an edge stack since
+ * it was at position pnt (see get_curpnt_edgestack()):  the edges are
+ * popped and added back to the graph
+ */
+void
+rollback_edgestack(
+  graph_type *graph,
+  edgestack_type *edges,
+  int pnt)
+{
+  int v1, v2;
+
+  while (edges->pointer > pnt)
+  {
+    pop_edge_from_stack(&v1, &v2, edges);
+    add_edge_graph(graph, v1, v2);
+  }
+
+}  /* end of rollback_edgestack() */
+
+
 /************************************************************/
 /* function to initialize an edge stack
  */
@@ -479,6 +580,7 @@ hc_do_pruning(
   					graph->deg[loop]);
             fprintf(g_options.log_fp, "which implies no hamiltonian cycle.\n");
           }
+          g_prune_cause = CAUSE_DEGREE;
           return(HC_NOT_EXIST);
         }
       }
@@ -502,6 +604,7 @@ hc_do_pruning(
               "Vertex %d has %d neighbours of degree 2, ", loop, degmrk[loop]);
            fprintf(g_options.log_fp, "which implies no hamiltonian cycle.\n");
           }
+          g_prune_cause = CAUSE_DEG2NBR;
           return(HC_NOT_EXIST);
         }
       }
@@ -560,6 +663,7 @@ hc_do_pruning(
               fprintf(g_options.log_fp, 
                 "which implies no hamiltonian cycle.\n");
             }
+            g_prune_cause = CAUSE_SHORTCYC;
             return(HC_NOT_EXIST);
           }
     
@@ -587,13 +691,18 @@ hc_do_pruning(
   /* check for components */
   if (prunelevel & HC_PRUNE_CONNECT)
   {
-    if (calc_graph_components(graph) > 1) 
+    PHASE_START(PHASE_CHECK);
+    ret = calc_graph_components(graph);
+    PHASE_STOP(PHASE_CHECK);
+
+    if (ret > 1) 
     {
       if (g_options.report_flags & REPORT_ALG)
       {
         fprintf(g_options.log_fp, "The graph has multiple components, ");
         fprintf(g_options.log_fp, "which implies no hamiltonian cycle.\n");
       }
+      g_prune_cause = CAUSE_CONNECT;
       return(HC_NOT_EXIST);
     } 
   }
@@ -601,13 +710,18 @@ hc_do_pruning(
   /* check for articulation points */
   if (prunelevel & HC_PRUNE_CUTPOINT)
   {
-    if (check_graph_cutpoints(graph) == CUTPNT_EXIST)
+    PHASE_START(PHASE_CHECK);
+    ret = check_graph_cutpoints(graph);
+    PHASE_STOP(PHASE_CHECK);
+
+    if (ret == CUTPNT_EXIST)
     {
       if (g_options.report_flags & REPORT_ALG)
       {
         fprintf(g_options.log_fp, "The graph has at least one cutpoint, ");
         fprintf(g_options.log_fp, "which implies no hamiltonian cycle.\n");
       }
+      g_prune_cause = CAUSE_CUTPOINT;
       return(HC_NOT_EXIST);
     }
   }
@@ -617,6 +731,18 @@ hc_do_pruning(
 }  /* end of hc_do_pruning() */
 
 
+/************************************************************/
+/* returns the reason (CAUSE_*) the last call to hc_do_pruning() returned 
+ * HC_NOT_EXIST
+ */
+int
+hc_prune_cause()
+{
+  return(g_prune_cause);
+
+}  /* end of hc_prune_cause() */
+
+
 /************************************************************/
 /* function to add a vertex to the current path
  *   vert = new vertex
@@ -625,7 +751,7 @@ hc_do_pruning(
 void
 add_vert_to_path(
   path_type path[],
-  graphpath_type graphpath[],
+  graphpath_type *graphpath,
   int *pstart,
   int *pend,
   int *plength,
@@ -634,7 +760,7 @@ add_vert_to_path(
   path[*pend].next = *plength;
   path[*plength].gvert = vert;
   path[*plength].next = -1;
-  graphpath[vert].pathpos = *plength;
+  graphpath->pathpos[vert] = *plength;
   *pend = *plength;
   (*plength)++;
 
@@ -653,13 +779,13 @@ add_vert_to_path(
 void
 remove_endvert_from_path(
   path_type path[],
-  graphpath_type graphpath[],
+  graphpath_type *graphpath,
   int *pstart,
   int *pend,
   int *plength,
   int oldend)
 {
-  graphpath[path[*pend].gvert].pathpos = -1;
+  graphpath->pathpos[path[*pend].gvert] = -1;
   path[*pend].gvert = -1;
   path[*pend].next = -1;
   *pend = oldend;
@@ -669,6 +795,190 @@ remove_endvert_from_path(
 }  /* end of remove_endvert_from_path() */
 
 
+/************************************************************/
+/* function to add a vertex to the start of the current path
+ * (for the bidirectional backtrack, +bidir)
+ *   vert = new vertex
+ *   assumes vertices stored in path[] from 0 to *plength-1
+ */
+void
+add_startvert_to_path(
+  path_type path[],
+  graphpath_type *graphpath,
+  int *pstart,
+  int *pend,
+  int *plength,
+  int vert)
+{
+  path[*plength].gvert = vert;
+  path[*plength].next = *pstart;
+  graphpath->pathpos[vert] = *plength;
+  *pstart = *plength;
+  (*plength)++;
+
+}  /* end of add_startvert_to_path() */
+
+
+/************************************************************/
+/* function to remove the start vertex of the current path, which must
+ * be the last vertex added (at location *plength-1), as it is when
+ * backing up
+ */
+void
+remove_startvert_from_path(
+  path_type path[],
+  graphpath_type *graphpath,
+  int *pstart,
+  int *pend,
+  int *plength)
+{
+  int oldstart = *pstart;
+
+  graphpath->pathpos[path[oldstart].gvert] = -1;
+  *pstart = path[oldstart].next;
+  path[oldstart].gvert = -1;
+  path[oldstart].next = -1;
+  (*plength)--;
+
+}  /* end of remove_startvert_from_path() */
+
+
+/************************************************************/
+/* neighbour classification.
+ * sets bit x of *unvisited if graph->nbr[vert][x] is not in the path, and
+ * bit x of *forced if it is also of degree 2.  this is the inner scan of
+ * the backtrack and posa's, so there is an avx2 version (gathering deg[]
+ * and pathpos[] of 8 neighbours at a time), used when the cpu has it.
+ */
+
+/* the version to use:  set on the first call */
+void (*g_classify_nbrs)( graph_type *graph, graphpath_type *graphpath,
+  int vert, nbrmask_type *unvisited, nbrmask_type *forced) = NULL;
+
+
+/************************************************************/
+/* scalar classification of neighbours first ... deg-1 (bits are or'ed
+ * into the masks)
+ */
+void
+hc_classify_nbrs_from(
+  graph_type *graph,
+  graphpath_type *graphpath,
+  int vert,
+  int first,
+  nbrmask_type *unvisited,
+  nbrmask_type *forced)
+{
+  int loop;
+  int nbr;
+
+  for (loop = first; loop < graph->deg[vert]; loop++)
+  {
+    nbr = graph->nbr[vert][loop];
+    if (graphpath->pathpos[nbr] == -1)
+    {
+      *unvisited |= 1ULL << loop;
+      if (graph->deg[nbr] == 2)
+        *forced |= 1ULL << loop;
+    }
+  }
+
+}  /* end of hc_classify_nbrs_from() */
+
+
+/************************************************************/
+/* scalar version of hc_classify_nbrs() */
+void
+hc_classify_nbrs_scalar(
+  graph_type *graph,
+  graphpath_type *graphpath,
+  int vert,
+  nbrmask_type *unvisited,
+  nbrmask_type *forced)
+{
+  *unvisited = 0;
+  *forced = 0;
+  hc_classify_nbrs_from(graph, graphpath, vert, 0, unvisited, forced);
+
+}  /* end of hc_classify_nbrs_scalar() */
+
+
+#ifdef HC_NBR_AVX2
+/************************************************************/
+/* avx2 version of hc_classify_nbrs().  the neighbours are done 8 at a
+ * time, the last (deg % 8) with the scalar loop.  pathpos[] entries may be
+ * 16 bits, so they are gathered as 32 bit words and sign extended (the
+ * upper half read belongs to the next entry, or to ended[] for the last
+ * vertex)
+ */
+__attribute__((target("avx2")))
+void
+hc_classify_nbrs_avx2(
+  graph_type *graph,
+  graphpath_type *graphpath,
+  int vert,
+  nbrmask_type *unvisited,
+  nbrmask_type *forced)
+{
+  int loop;
+  int deg = graph->deg[vert];
+  nbrmask_type unv = 0, frc = 0;
+  __m256i idx, pos, vdeg;
+  __m256i minus1 = _mm256_set1_epi32(-1);
+  __m256i two = _mm256_set1_epi32(2);
+  __m256i isunv, isfrc;
+
+  for (loop = 0; loop + 8 <= deg; loop += 8)
+  {
+    idx = _mm256_loadu_si256((__m256i *) &(graph->nbr[vert][loop]));
+    vdeg = _mm256_i32gather_epi32(graph->deg, idx, 4);
+    pos = _mm256_i32gather_epi32((int *) graphpath->pathpos, idx,
+		sizeof(vertid_type));
+    if (sizeof(vertid_type) < sizeof(int))
+      pos = _mm256_srai_epi32(_mm256_slli_epi32(pos, 16), 16);
+
+    isunv = _mm256_cmpeq_epi32(pos, minus1);
+    isfrc = _mm256_and_si256(isunv, _mm256_cmpeq_epi32(vdeg, two));
+    unv |= (nbrmask_type) _mm256_movemask_ps(_mm256_castsi256_ps(isunv))
+		<< loop;
+    frc |= (nbrmask_type) _mm256_movemask_ps(_mm256_castsi256_ps(isfrc))
+		<< loop;
+  }
+
+  *unvisited = unv;
+  *forced = frc;
+  hc_classify_nbrs_from(graph, graphpath, vert, loop, unvisited, forced);
+
+}  /* end of hc_classify_nbrs_avx2() */
+#endif  /* HC_NBR_AVX2 */
+
+
+/************************************************************/
+/* function to classify the neighbours of vert (see above).  picks the
+ * avx2 or scalar version on the first call
+ */
+void
+hc_classify_nbrs(
+  graph_type *graph,
+  graphpath_type *graphpath,
+  int vert,
+  nbrmask_type *unvisited,
+  nbrmask_type *forced)
+{
+  if (g_classify_nbrs == NULL)
+  {
+    g_classify_nbrs = hc_classify_nbrs_scalar;
+#ifdef HC_NBR_AVX2
+    if (__builtin_cpu_supports("avx2"))
+      g_classify_nbrs = hc_classify_nbrs_avx2;
+#endif
+  }
+
+  g_classify_nbrs(graph, graphpath, vert, unvisited, forced);
+
+}  /* end of hc_classify_nbrs() */
+
+
 /************************************************************/
 /* rotational transformation to reverse path in cycle.
  * ie: A-B-C-D, edge from D-A
@@ -684,7 +994,7 @@ remove_endvert_from_path(
 void
 hc_reverse_path(
   path_type path[],
-  graphpath_type graphpath[],
+  graphpath_type *graphpath,
   int *endpathv,
   int revpathv,
   int plength)
@@ -714,7 +1024,7 @@ hc_reverse_path(
   /* set up new end of path */
   path[newend].next = -1;
   *endpathv = newend;
-  graphpath[path[newend].gvert].ended = plength;   /* for posa's only */
+  graphpath->ended[path[newend].gvert] = plength;   /* for posa's only */
 
 }  /* end of hc_reverse_path() */
 
@@ -739,7 +1049,7 @@ int
 hc_path_to_cycle(
   graph_type *graph,
   path_type path[],
-  graphpath_type graphpath[],
+  graphpath_type *graphpath,
   int *pstart, 
   int *pend,
   int plength)
@@ -763,7 +1073,7 @@ hc_path_to_cycle(
     tempvert = graph->nbr[path[*pend].gvert][loop];
 
     /* get next vertex in path */
-    tempnum = graphpath[tempvert].pathpos;
+    tempnum = graphpath->pathpos[tempvert];
     tempnum = path[tempnum].next;
     curvert = path[tempnum].gvert;
 
@@ -771,7 +1081,7 @@ hc_path_to_cycle(
     if (check_if_edge(graph, curvert, path[*pstart].gvert) == EDGE_EXIST)
     {
       /* do reversal of path */
-      hc_reverse_path(path, graphpath, pend, graphpath[tempvert].pathpos, 
+      hc_reverse_path(path, graphpath, pend, graphpath->pathpos[tempvert], 
 			plength);
 
       return(HC_FOUND);
@@ -784,6 +1094,324 @@ hc_path_to_cycle(
 }  /* end of hc_path_to_cycle() */
   
 
+/************************************************************/
+/* this function contracts the forced chains of a (pruned) graph:
+ * each maximal path u - x1 - ... - xk - w of degree 2 vertices between
+ * two vertices u, w of higher degree is replaced by u - x1 - w, so that
+ * x1 stands for the whole chain.  any \hc\ of the graph corresponds to
+ * exactly one \hc\ of the reduced graph and vice versa.
+ *
+ * the reduced graph is built in redgraph (with its vertices renumbered
+ * 0 ... numred-1), and the information needed to expand a solution of
+ * it back onto the original graph is stored in reduce.
+ * returns the number of vertices removed
+ *
+ * assumes that the graph has been pruned with HC_PRUNE_ALL
+ * (so there are no forced cycles, which are left alone anyways)
+ */
+int
+hc_contract_chains(
+  graph_type *graph,
+  graph_type *redgraph,
+  hc_reduce_type *reduce)
+{
+  int inchain[MAXVERT];		/* 1 if vertex is in an examined chain */
+  int repvert[MAXVERT];		/* representative of each removed vertex */
+  int otherend[MAXVERT];	/* (by representative) w end of its chain */
+  int newlabel[MAXVERT];
+  int numchainvert = 0;
+  int chainlen;
+  int loop, eloop;
+  int prevvert, curvert, nextvert;
+  int rep;
+
+  reduce->numvert = graph->numvert;
+  reduce->numchains = 0;
+
+  for (loop = 0; loop < graph->numvert; loop++)
+  {
+    inchain[loop] = 0;
+    repvert[loop] = -1;
+    reduce->chainlen[loop] = 0;
+  }
+
+  /* walk each chain starting from a vertex of degree > 2 */
+  for (loop = 0; loop < graph->numvert; loop++)
+  {
+    if (graph->deg[loop] <= 2)
+      continue;
+
+    for (eloop = 0; eloop < graph->deg[loop]; eloop++)
+    {
+      curvert = graph->nbr[loop][eloop];
+      if ( (graph->deg[curvert] != 2) || inchain[curvert] )
+        continue;
+
+      /* follow the chain, recording it at the end of chainvert[] */
+      prevvert = loop;
+      chainlen = 0;
+      while (graph->deg[curvert] == 2)
+      {
+        inchain[curvert] = 1;
+        reduce->chainvert[numchainvert + chainlen] = curvert;
+        chainlen++;
+
+        if (graph->nbr[curvert][0] != prevvert)
+          nextvert = graph->nbr[curvert][0];
+        else
+          nextvert = graph->nbr[curvert][1];
+        prevvert = curvert;
+        curvert = nextvert;
+      }
+
+      /* nothing to gain from a chain of 1, and a chain back to the
+       * same vertex is a forced short cycle (left for the pruning)
+       */
+      if ( (chainlen < 2) || (curvert == loop) )
+        continue;
+
+      rep = reduce->chainvert[numchainvert];
+      reduce->chainlen[rep] = chainlen;
+      reduce->chainstart[rep] = numchainvert;
+      reduce->chainend[rep] = loop;
+      otherend[rep] = curvert;
+
+      while (--chainlen > 0)
+        repvert[reduce->chainvert[numchainvert + chainlen]] = rep;
+
+      numchainvert += reduce->chainlen[rep];
+      reduce->numchains++;
+    }
+  }
+
+  /* number the vertices which are left */
+  reduce->numred = 0;
+  for (loop = 0; loop < graph->numvert; loop++)
+  {
+    if (repvert[loop] == -1)
+    {
+      newlabel[loop] = reduce->numred;
+      reduce->orgvert[reduce->numred] = loop;
+      reduce->numred++;
+    }
+  }
+
+  /* build reduced graph: edges into a removed vertex go to the chain's
+   * representative instead (or for the representative, to the far end)
+   */
+  init_graph(redgraph);
+  redgraph->numvert = reduce->numred;
+  for (loop = 0; loop < graph->numvert; loop++)
+  {
+    if (repvert[loop] != -1)
+      continue;
+
+    for (eloop = 0; eloop < graph->deg[loop]; eloop++)
+    {
+      nextvert = graph->nbr[loop][eloop];
+      if (repvert[nextvert] != -1)
+      {
+        if (repvert[nextvert] == loop)
+          nextvert = otherend[loop];
+        else
+          nextvert = repvert[nextvert];
+      }
+      add_direct_edge_graph(redgraph, newlabel[loop], newlabel[nextvert]);
+    }
+  }
+
+  calc_graph_stats(redgraph);
+
+  return(graph->numvert - reduce->numred);
+
+}  /* end of hc_contract_chains() */
+
+
+/************************************************************/
+/* this function maps a solution (\hc\) of a reduced graph back onto
+ * the original graph, by renumbering the vertices and putting the
+ * contracted chains back in.  the solution is changed in place.
+ */
+void
+hc_expand_solution(
+  hc_reduce_type *reduce,
+  int solution[])
+{
+  int expanded[MAXVERT];
+  int num = 0;
+  int loop, cloop;
+  int vert, prevvert;
+  int first, len;
+
+  for (loop = 0; loop < reduce->numred; loop++)
+  {
+    vert = reduce->orgvert[solution[loop]];
+    len = reduce->chainlen[vert];
+
+    if (len == 0)
+    {
+      expanded[num++] = vert;
+      continue;
+    }
+
+    /* put the chain in, in the direction the cycle passes through it */
+    first = reduce->chainstart[vert];
+    prevvert = reduce->orgvert[solution[(loop + reduce->numred - 1) % 
+		reduce->numred]];
+    if (prevvert == reduce->chainend[vert])
+    {
+      for (cloop = 0; cloop < len; cloop++)
+        expanded[num++] = reduce->chainvert[first + cloop];
+    }
+    else
+    {
+      for (cloop = len-1; cloop >= 0; cloop--)
+        expanded[num++] = reduce->chainvert[first + cloop];
+    }
+  }
+
+  for (loop = 0; loop < reduce->numvert; loop++)
+    solution[loop] = expanded[loop];
+
+}  /* end of hc_expand_solution() */
+
+
+/************************************************************/
+/* this function sets up reduce as the identity mapping (nothing 
+ * contracted) of a graph with numvert vertices
+ */
+void
+hc_init_reduce(
+  hc_reduce_type *reduce,
+  int numvert)
+{
+  int loop;
+
+  reduce->numvert = numvert;
+  reduce->numred = numvert;
+  reduce->numchains = 0;
+
+  for (loop = 0; loop < numvert; loop++)
+  {
+    reduce->orgvert[loop] = loop;
+    reduce->chainlen[loop] = 0;
+  }
+
+}  /* end of hc_init_reduce() */
+
+
+/************************************************************/
+/* this function relabels the vertices of graph into newgraph, in 
+ * breadth first search order (RELABEL_BFS) or reverse cuthill-mckee order
+ * (RELABEL_RCM:  bfs from a minimum degree vertex, visiting neighbours in
+ * increasing degree order, then reversed).  either way neighbours get
+ * nearby labels, so the search's accesses to the per vertex arrays are
+ * close together (instead of scattered by random_permute_graph()).  the
+ * neighbour lists are sorted by the new labels.
+ *
+ * graph's vertices are those of the reduced graph in reduce (set up by
+ * hc_contract_chains() or hc_init_reduce()), and the relabelling is 
+ * composed into reduce->orgvert[], so hc_expand_solution() maps a 
+ * solution of newgraph onto the original graph.
+ */
+void
+hc_relabel_graph(
+  graph_type *graph,
+  graph_type *newgraph,
+  hc_reduce_type *reduce,
+  int relabelflag)
+{
+  int order[MAXVERT];
+  int newlabel[MAXVERT];
+  int orgvert[MAXVERT];
+  int row[MAXDEGREE];
+  int head, tail;
+  int first, tmp;
+  int curvert, nextvert;
+  int loop, eloop, sloop;
+
+  for (loop = 0; loop < graph->numvert; loop++)
+    newlabel[loop] = -1;
+
+  /* bfs, from a minimum degree vertex of each component */
+  head = tail = 0;
+  while (tail < graph->numvert)
+  {
+    first = -1;
+    for (loop = 0; loop < graph->numvert; loop++)
+    {
+      if ( (newlabel[loop] == -1) && 
+	   ( (first == -1) || (graph->deg[loop] < graph->deg[first]) ) )
+        first = loop;
+    }
+
+    order[tail++] = first;
+    newlabel[first] = 0;		/* mark as queued */
+
+    while (head < tail)
+    {
+      curvert = order[head++];
+      first = tail;
+      for (eloop = 0; eloop < graph->deg[curvert]; eloop++)
+      {
+        nextvert = graph->nbr[curvert][eloop];
+        if (newlabel[nextvert] == -1)
+        {
+          newlabel[nextvert] = 0;
+          order[tail++] = nextvert;
+        }
+      }
+
+      /* rcm:  queue the new neighbours in increasing degree order */
+      if (relabelflag == RELABEL_RCM)
+      {
+        for (loop = first + 1; loop < tail; loop++)
+        {
+          tmp = order[loop];
+          for (sloop = loop; (sloop > first) && 
+		(graph->deg[order[sloop-1]] > graph->deg[tmp]); sloop--)
+            order[sloop] = order[sloop-1];
+          order[sloop] = tmp;
+        }
+      }
+    }
+  }
+
+  for (loop = 0; loop < graph->numvert; loop++)
+  {
+    if (relabelflag == RELABEL_RCM)
+      newlabel[order[loop]] = graph->numvert - 1 - loop;
+    else
+      newlabel[order[loop]] = loop;
+  }
+
+  /* build the relabelled graph, with sorted neighbour lists */
+  init_graph(newgraph);
+  newgraph->numvert = graph->numvert;
+  for (loop = 0; loop < graph->numvert; loop++)
+  {
+    for (eloop = 0; eloop < graph->deg[loop]; eloop++)
+    {
+      tmp = newlabel[graph->nbr[loop][eloop]];
+      for (sloop = eloop; (sloop > 0) && (row[sloop-1] > tmp); sloop--)
+        row[sloop] = row[sloop-1];
+      row[sloop] = tmp;
+    }
+
+    for (eloop = 0; eloop < graph->deg[loop]; eloop++)
+      add_direct_edge_graph(newgraph, newlabel[loop], row[eloop]);
+
+    orgvert[newlabel[loop]] = reduce->orgvert[loop];
+  }
+
+  calc_graph_stats(newgraph);
+
+  for (loop = 0; loop < graph->numvert; loop++)
+    reduce->orgvert[loop] = orgvert[loop];
+
+}  /* end of hc_relabel_graph() */
+
+
 /************************************************************/
 /* testing wrapper for hamiltonian cycle algorithms
  *
@@ -801,8 +1429,7 @@ test_hc_alg(
   int retval = RUN_NORMAL;
 
   int hcret = 0;
-  long timeret;
-  struct rusage curtime;
+  struct timeval curtime;
   int solution[MAXVERT];
 
   int loop;
@@ -823,17 +1450,33 @@ test_hc_alg(
         fprintf(g_options.log_fp, 
 	"Starting pruning backtrack algorithm to find hamiltonian cycle...\n");
         break;
+      case ALG_ANNEAL:
+        fprintf(g_options.log_fp, 
+	"Starting annealing local search to find hamiltonian cycle...\n");
+        break;
+      case ALG_DECOMP:
+        fprintf(g_options.log_fp, 
+	"Starting decomposition at vertex cuts to find hamiltonian cycle...\n");
+        break;
+      case ALG_LEARN:
+        fprintf(g_options.log_fp, 
+	"Starting clause learning search to find hamiltonian cycle...\n");
+        break;
       default:
         EXIT_ERROR("Invalid algorithm in test_hc_alg().\n");
         break;
     }
   }
 
+  /* the scratch memory of the previous trial is not needed anymore */
+  arena_reset();
+
   /* start stat timer */
-  g_hit_timelimit = RUN_NORMAL;
-  timeret = getrusage(RUSAGE_SELF,&curtime);
-  g_algstart.tv_sec = curtime.ru_utime.tv_sec;
-  g_algstart.tv_usec = curtime.ru_utime.tv_usec;
+  phase_reset();
+  hc_start_timer();
+
+  if (g_options.report_flags & REPORT_HWCOUNTERS)
+    hw_counters_start();
 
   /* run algorithm */
   switch(g_options.algorithm)
@@ -846,12 +1489,31 @@ test_hc_alg(
     case ALG_POSA_HEUR:
       hcret = master_heuristic_alg(graph, trialstats, solution);
       break;
+
+    case ALG_ANNEAL:
+      hcret = master_anneal_alg(graph, trialstats, solution);
+      break;
+
+    case ALG_DECOMP:
+      hcret = master_decomp_alg(graph, trialstats, solution);
+      break;
+
+    case ALG_LEARN:
+      hcret = master_learn_alg(graph, trialstats, solution);
+      break;
+  }
+
+  if (g_options.report_flags & REPORT_HWCOUNTERS)
+  {
+    hw_counters_stop(trialstats);
+    if (g_options.report_flags & REPORT_ALG)
+      print_hw_counters(g_options.log_fp, trialstats);
   }
 
   /* stop timing, and calculate elapsed time in seconds */
-  timeret = getrusage(RUSAGE_SELF,&curtime);
-  g_algstart.tv_sec = curtime.ru_utime.tv_sec - g_algstart.tv_sec;
-  g_algstart.tv_usec = curtime.ru_utime.tv_usec - g_algstart.tv_usec;
+  hc_get_cputime(&curtime);
+  g_algstart.tv_sec = curtime.tv_sec - g_algstart.tv_sec;
+  g_algstart.tv_usec = curtime.tv_usec - g_algstart.tv_usec;
   trialstats->time = g_algstart.tv_sec + ((float)g_algstart.tv_usec/1000000.0);
 
   trialstats->result = hcret;
@@ -872,12 +1534,22 @@ test_hc_alg(
   /* verify solution */
   if (hcret == HC_FOUND)
   {
+      PHASE_START(PHASE_VERIFY);
       if (hc_verify_solution(graph, solution) == HC_NOT_VERIFY)
       {
         EXIT_ERROR("Error:  algorithm calculated bad solution.\n");
       }
+      PHASE_STOP(PHASE_VERIFY);
   }
 
+#if PHASE_TIMING
+  phase_save(trialstats);
+  if (g_options.report_flags & REPORT_ALG) 
+  {
+    print_phase_times(g_options.log_fp, trialstats->phasetime);
+  }
+#endif
+
   /* print solution status */
   if (g_options.report_flags & REPORT_ALG) 
   {
@@ -887,10 +1559,16 @@ test_hc_alg(
       fprintf(g_options.log_fp, "Hamiltonian cycle does not exist.\n");
     else if (hcret == HC_NOT_FOUND)
       fprintf(g_options.log_fp, "Hamiltonian cycle not found.\n");
+
+    if (trialstats->hccount >= 0)
+      print_count_result(g_options.log_fp, trialstats);
   }
 
-  /* print solution if found */
-  if (g_options.report_flags & REPORT_SOLUTION)
+  /* print solution if found (each cycle counted is already written out
+   * when listing them)
+   */
+  if ( (g_options.report_flags & REPORT_SOLUTION) &&
+       !( (trialstats->hccount >= 0) && (g_count.enumerate) ) )
   {
     if (hcret == HC_FOUND)
     {
@@ -11,19 +11,47 @@
 
 /* data structure for hamiltonian cycle algorithms:  path structures */
 
+/* vertex # / path position as stored in the path structures.  these are
+ * what the search reads and writes at every node, so they are kept to 16
+ * bits when MAXVERT allows (halving the cache lines touched).  signed,
+ * since -1 marks "not in path".  compile with -DHC_WIDE_VERTID to use ints
+ */
+#if (MAXVERT <= 32767) && !defined(HC_WIDE_VERTID)
+typedef short vertid_type;
+#else
+typedef int vertid_type;
+#endif
+
 /* to be indexed by path position */
 typedef struct {
-  int gvert;    /* graph vertex # */
-  int next;     /* points to location in this array of next vertex in path */
+  vertid_type gvert;	/* graph vertex # */
+  vertid_type next;	/* points to location in this array of next vertex
+			 * in path */
   } path_type;
 
-/* to be indexed by graph vertex # */
+/* to be indexed by graph vertex # (graphpath.pathpos[v]).  kept as
+ * separate arrays so that the backtrackers, which only use pathpos, don't
+ * pull the posa's ended[] entries into the cache
+ */
 typedef struct {
-   int pathpos; /* position in path (-1 if not in path) */
-   int ended;   /* length of path ended on this vertex (to avoid repeats) */
-                /* for posa's only */
+  vertid_type pathpos[MAXVERT];	/* position in path (-1 if not in path) */
+  int ended[MAXVERT];	/* length of path ended on this vertex (to avoid
+			 * repeats).  for posa's only */
   } graphpath_type;
 
+/* neighbour masks (see hc_classify_nbrs()):  bit x stands for
+ * graph->nbr[v][x]
+ */
+typedef unsigned long long nbrmask_type;
+
+#if (MAXDEGREE > 64)
+#error "nbrmask_type needs MAXDEGREE <= 64"
+#endif
+
+#define NBRMASK_COUNT(mask)	__builtin_popcountll(mask)
+#define NBRMASK_FIRST(mask)	__builtin_ctzll(mask)	/* mask != 0 */
+#define NBRMASK_LAST(mask)	(63 - __builtin_clzll(mask))	/* mask != 0 */
+
 
 /* defines for prunelevel in hc_do_pruning() */
 #define HC_PRUNE_NONE  0x0
@@ -34,6 +62,23 @@ typedef struct {
 #define HC_PRUNE_ALL (HC_PRUNE_BASIC | HC_PRUNE_CYC | HC_PRUNE_CONNECT | \
 HC_PRUNE_CUTPOINT)
 
+/* reachability check from the path end:  this needs the current path, 
+ * so it is done by the pruning backtrack itself (not by hc_do_pruning) 
+ */
+#define HC_PRUNE_REACH 0x10
+
+/* reasons for a HC_NOT_EXIST from hc_do_pruning() (see hc_prune_cause()),
+ * and from the checks done by the pruning backtrack itself
+ */
+#define CAUSE_DEGREE	0	/* a vertex has degree < 2 */
+#define CAUSE_DEG2NBR	1	/* a vertex has > 2 neighbours of degree 2 */
+#define CAUSE_SHORTCYC	2	/* forced edges make a short cycle */
+#define CAUSE_CONNECT	3	/* graph is not connected */
+#define CAUSE_CUTPOINT	4	/* graph has a cutpoint */
+#define CAUSE_REACH	5	/* vertex unreachable from the path ends */
+#define CAUSE_MEMO	6	/* state is in the failed state memo table */
+#define NUM_CAUSES	7
+
 /* data structures for saving deleted edges */
 typedef struct {
   int v1;
@@ -45,6 +90,36 @@ typedef struct {
   int pointer;
   } edgestack_type;
 
+/* data structure to map a solution of a reduced graph (one with its
+ * forced chains contracted) back onto the original graph.
+ * a forced chain u - x1 - x2 ... - xk - w (all xi degree 2) is 
+ * contracted to u - x1 - w, and x1 then stands for the whole chain.
+ * arrays marked (orig) are indexed by original vertex #
+ */
+typedef struct {
+  int numvert;			/* # of vertices of the original graph */
+  int numred;			/* # of vertices of the reduced graph */
+  int numchains;		/* # of chains contracted */
+  int orgvert[MAXVERT];		/* original vertex # of each reduced vertex */
+  int chainlen[MAXVERT];	/* (orig) # of vertices in the chain that
+				 * this vertex stands for (0 if none) */
+  int chainstart[MAXVERT];	/* (orig) index of chain in chainvert[] */
+  int chainend[MAXVERT];	/* (orig) neighbour of the chain at the
+				 * chainvert[chainstart] end (u above) */
+  int chainvert[MAXVERT];	/* vertices of all the chains, in order */
+  } hc_reduce_type;
+
+/* values for contractflag options */
+#define NOCONTRACT 0
+#define CONTRACT 1
+
+/* values for relabelflag options:  relabel the vertices of the working 
+ * graph after the initial pruning so that neighbours get nearby labels
+ */
+#define RELABEL_NONE 0
+#define RELABEL_BFS 1		/* breadth first search order */
+#define RELABEL_RCM 2		/* reverse cuthill-mckee order */
+
 /* defines for the possible return values from the posa algorithm
  * hc_not_found - no cycle found, but one may exist
  * hc_not_exist - no cycle can exist on this graph
@@ -75,6 +150,16 @@ typedef struct {
 /* function declarations */
 /************************************************************/
 
+float hc_get_elapsed_time();
+
+void hc_get_cputime( struct timeval *cputime);
+
+void hc_start_timer();
+
+void hc_fork_timer( float used);
+
+void hc_set_timelimit_hit();
+
 int hc_check_timelimit();
 
 int hc_verify_solution( graph_type *graph, int solution[]);
@@ -85,6 +170,8 @@ void pop_edge_from_stack( int *v1, int *v2, edgestack_type *edges);
 
 void copy_edgestack( edgestack_type *fromstack, edgestack_type *tostack);
 
+void rollback_edgestack( graph_type *graph, edgestack_type *edges, int pnt);
+
 void init_edgestack( edgestack_type *edges);
 
 int get_curpnt_edgestack( edgestack_type *edges);
@@ -94,17 +181,38 @@ int select_initvertex( graph_type *graph, int selectflag);
 int hc_do_pruning( graph_type *graph, int *prune, int prunelevel,
   edgestack_type *edgestack);
 
-void add_vert_to_path( path_type path[], graphpath_type graphpath[], 
+int hc_prune_cause();
+
+void add_vert_to_path( path_type path[], graphpath_type *graphpath, 
   int *pstart, int *pend, int *plength, int vert);
 
-void remove_endvert_from_path( path_type path[], graphpath_type graphpath[],
+void remove_endvert_from_path( path_type path[], graphpath_type *graphpath,
   int *pstart, int *pend, int *plength, int oldend);
 
-void hc_reverse_path( path_type path[], graphpath_type graphpath[],
+void add_startvert_to_path( path_type path[], graphpath_type *graphpath,
+  int *pstart, int *pend, int *plength, int vert);
+
+void remove_startvert_from_path( path_type path[],
+  graphpath_type *graphpath, int *pstart, int *pend, int *plength);
+
+void hc_classify_nbrs( graph_type *graph, graphpath_type *graphpath,
+  int vert, nbrmask_type *unvisited, nbrmask_type *forced);
+
+void hc_reverse_path( path_type path[], graphpath_type *graphpath,
   int *endpathv, int revpathv, int plength);
 
 int hc_path_to_cycle( graph_type *graph, path_type path[],
-  graphpath_type graphpath[], int *pstart, int *pend, int plength);
+  graphpath_type *graphpath, int *pstart, int *pend, int plength);
+
+int hc_contract_chains( graph_type *graph, graph_type *redgraph, 
+  hc_reduce_type *reduce);
+
+void hc_expand_solution( hc_reduce_type *reduce, int solution[]);
+
+void hc_init_reduce( hc_reduce_type *reduce, int numvert);
+
+void hc_relabel_graph( graph_type *graph, graph_type *newgraph,
+  hc_reduce_type *reduce, int relabelflag);
 
 int test_hc_alg( graph_type *graph, stat_pertrial_type *trialstats);
 
@@ -18,7 +18,7 @@ void
 debug_print_path(
   graph_type *graph,
   path_type path[],
-  graphpath_type graphpath[],
+  graphpath_type *graphpath,
   int startpathv,
   int endpathv,
   int pathlength)
@@ -52,11 +52,11 @@ debug_print_path(
     fprintf(g_options.log_fp, "  path position %d = graph vertex %d\n",
       curpath, curvert);
     
-    if (graphpath[curvert].pathpos != curpath)
+    if (graphpath->pathpos[curvert] != curpath)
     {
       fprintf(g_options.log_fp, 
 	"    Error: invalid graphpath.pathpos entry = %d\n",
-           graphpath[curvert].pathpos);
+           graphpath->pathpos[curvert]);
     }
 
     if ( (count == pathlength) && (curpath != endpathv) )
@@ -101,7 +101,7 @@ int
 do_cycle_extend(
   graph_type *graph,
   path_type path[],
-  graphpath_type graphpath[],
+  graphpath_type *graphpath,
   int *pathstart,
   int *pathend,
   int pathlength)
@@ -113,6 +113,7 @@ do_cycle_extend(
   int newvert = 0;
 
   int loop;
+  int ret;
 
   /* indicates which edge to break (actual position in terms of # of
    * vertices down the path.  if = -1, then want to break edge between 
@@ -121,12 +122,16 @@ do_cycle_extend(
   int breakposition = 0;
 
   path_type tmppath[MAXVERT];
-  graphpath_type tmpgraphpath[MAXVERT];
+  graphpath_type tmpgraphpath;
   int tmpcur;
 
   /* first try to find a cycle */
-  if (hc_path_to_cycle(graph, path, graphpath, pathstart, pathend, pathlength)
-       == HC_FOUND)
+  PHASE_START(PHASE_CLOSE);
+  ret = hc_path_to_cycle(graph, path, graphpath, pathstart, pathend, 
+		pathlength);
+  PHASE_STOP(PHASE_CLOSE);
+
+  if (ret == HC_FOUND)
   {
     if ( (g_options.report_flags & REPORT_ALG) && (VERBOSE_MODE) )
     {
@@ -166,7 +171,7 @@ do_cycle_extend(
       for (loop = 0; loop < graph->deg[nextvert]; loop++) 
       {
         newvert = graph->nbr[nextvert][loop];
-        if (graphpath[newvert].pathpos == -1)
+        if (graphpath->pathpos[newvert] == -1)
         {
           foundvert = 1;
           break;
@@ -234,8 +239,8 @@ do_cycle_extend(
   {
     tmppath[loop].gvert = -1;
     tmppath[loop].next = -1;
-    tmpgraphpath[loop].pathpos = -1;
-    tmpgraphpath[loop].ended = -1;
+    tmpgraphpath.pathpos[loop] = -1;
+    tmpgraphpath.ended[loop] = -1;
   }
 
   /* copy section of old path from index 0 to nextnum-1 
@@ -245,8 +250,8 @@ do_cycle_extend(
   {
     tmppath[tmpcur].gvert = path[curnum].gvert;
     tmppath[tmpcur].next = tmpcur+1;
-    tmpgraphpath[tmppath[tmpcur].gvert].pathpos = tmpcur;
-    tmpgraphpath[tmppath[tmpcur].gvert].ended = 0;
+    tmpgraphpath.pathpos[tmppath[tmpcur].gvert] = tmpcur;
+    tmpgraphpath.ended[tmppath[tmpcur].gvert] = 0;
 
     /* advance index for old path */
     curnum = path[curnum].next;
@@ -262,8 +267,8 @@ do_cycle_extend(
   {
     tmppath[tmpcur].gvert = path[curnum].gvert;
     tmppath[tmpcur].next = tmpcur+1;
-    tmpgraphpath[tmppath[tmpcur].gvert].pathpos = tmpcur;
-    tmpgraphpath[tmppath[tmpcur].gvert].ended = 0;
+    tmpgraphpath.pathpos[tmppath[tmpcur].gvert] = tmpcur;
+    tmpgraphpath.ended[tmppath[tmpcur].gvert] = 0;
 
     /* advance index for old path */
     curnum = path[curnum].next;
@@ -271,7 +276,7 @@ do_cycle_extend(
 
   /* setup endpoint in path properly */
   tmppath[pathlength-1].next = -1;
-  tmpgraphpath[tmppath[pathlength-1].gvert].ended = pathlength;
+  tmpgraphpath.ended[tmppath[pathlength-1].gvert] = pathlength;
   *pathend = pathlength-1;
   *pathstart = 0;
 
@@ -280,8 +285,8 @@ do_cycle_extend(
   {
     path[loop].gvert = tmppath[loop].gvert;
     path[loop].next = tmppath[loop].next;
-    graphpath[loop].pathpos = tmpgraphpath[loop].pathpos;
-    graphpath[loop].ended = tmpgraphpath[loop].ended;
+    graphpath->pathpos[loop] = tmpgraphpath.pathpos[loop];
+    graphpath->ended[loop] = tmpgraphpath.ended[loop];
   }
 
   debug_print_path(graph, path, graphpath, *pathstart, *pathend, pathlength);
@@ -315,7 +320,7 @@ calc_posa_heur_alg(
   int *nodecount)
 {	
   path_type path[MAXVERT];
-  graphpath_type graphpath[MAXVERT];
+  graphpath_type graphpath;
 
   int pstart, pend, plength;	/* path start, path end, path length */
 
@@ -326,14 +331,15 @@ calc_posa_heur_alg(
   int loop;
   int curvert, tempvert, tempnum;
   int i;
+  nbrmask_type unvisited, forced;
 
   /* initialize variables */
   for (loop = 0; loop < graph->numvert; loop++)
   {
     path[loop].gvert = -1;
     path[loop].next = -1;
-    graphpath[loop].pathpos = -1;
-    graphpath[loop].ended = -1;
+    graphpath.pathpos[loop] = -1;
+    graphpath.ended[loop] = -1;
   }
 
   pstart = 0;
@@ -341,8 +347,8 @@ calc_posa_heur_alg(
   plength = 1;
   path[pstart].gvert = startv;
   path[pstart].next = -1;
-  graphpath[startv].pathpos = pstart;
-  graphpath[startv].ended = plength;
+  graphpath.pathpos[startv] = pstart;
+  graphpath.ended[startv] = plength;
 
   /* start loop of adding vertices to the path */
   while (!found)
@@ -353,6 +359,7 @@ calc_posa_heur_alg(
     curvert = path[pend].gvert;
     nextvert = -1;
     (*nodecount)++;	/* count iterations */
+    PROGRESS_NODE(plength);
 
     if (g_options.heur_alg.visitflag == VISIT_SMART)
     {
@@ -366,40 +373,24 @@ calc_posa_heur_alg(
        * 4.  select a (random) visited vertex (same as normal VISIT_RANDOM)
        */
 
+      hc_classify_nbrs(graph, &graphpath, curvert, &unvisited, &forced);
+
       /* 1. select a degree 2 neighbour (unvisited) */
-      for (loop = 0; loop < graph->deg[curvert]; loop++)
-      {
-        tempvert = graph->nbr[curvert][loop];
- 
-        if ( (graph->deg[tempvert] == 2) && 
-		(graphpath[tempvert].pathpos == -1) )
-        {
-          nextvert = tempvert;
-          break;
-        }
-      }
+      if (forced != 0)
+        nextvert = graph->nbr[curvert][NBRMASK_FIRST(forced)];
 
       if (nextvert == -1)	/* no vertex selected */
       {
         /* 2. select an unvisited vertex */
         /* start at random point in list of neighbours, to make selection
-         * random 
+         * random (first unvisited one at or after it, wrapping around)
          */
         tempnum = lrand48() % graph->deg[curvert];
-        loop = tempnum;
-        do 
-        {
-          tempvert = graph->nbr[curvert][loop];
-          if (graphpath[tempvert].pathpos == -1)
-          {
-            nextvert = tempvert;
-            break;
-          }
-          else
-          {
-           loop = (loop+1) % graph->deg[curvert];
-          }
-        }  while (loop != tempnum);
+        if ((unvisited >> tempnum) != 0)
+          nextvert = graph->nbr[curvert][tempnum + 
+			NBRMASK_FIRST(unvisited >> tempnum)];
+        else if (unvisited != 0)
+          nextvert = graph->nbr[curvert][NBRMASK_FIRST(unvisited)];
       }
 
       /* 3.  try cycle extend option, if set */
@@ -407,7 +398,7 @@ calc_posa_heur_alg(
 		(nextvert == -1))
       {
         /* search for a cycle */
-        nextvert = do_cycle_extend(graph, path, graphpath, &pstart, &pend,
+        nextvert = do_cycle_extend(graph, path, &graphpath, &pstart, &pend,
 			plength);
 
         /* if returned -1, then couldn't form circle, so continue as normal 
@@ -436,7 +427,7 @@ calc_posa_heur_alg(
       do 
       {
         tempvert = graph->nbr[curvert][loop];
-        if (graphpath[tempvert].pathpos == -1)  /* check if unvisited */
+        if (graphpath.pathpos[tempvert] == -1)  /* check if unvisited */
         {
           nextvert = tempvert;
           break;
@@ -445,10 +436,10 @@ calc_posa_heur_alg(
         /* visited vertex - check ended stat:  figure out new path
          * endpoint, based on posa's transformation
          * x = tempvert 
-         * graphpath[x].pathpos -> find location in path
+         * graphpath.pathpos[x] -> find location in path
          * path[x].next         -> find next element of path
          * path[x].gvert        -> find vertex # of next element in path
-         * graphpath[x].ended   -> this is the new end vertex: check ended
+         * graphpath.ended[x]   -> this is the new end vertex: check ended
          *                          parameter
          */
         /* visited vertex: check that we will not be breaking a forced edge.
@@ -456,10 +447,10 @@ calc_posa_heur_alg(
          * edge - don't do that
          * make this check only if smartvisit flag is set
          */
-        i = graphpath[tempvert].pathpos;
+        i = graphpath.pathpos[tempvert];
         i = path[i].next;
         i = path[i].gvert;
-        if ( (plength != graphpath[i].ended) &&
+        if ( (plength != graphpath.ended[i]) &&
              ( ( (g_options.heur_alg.visitflag == VISIT_SMART) &&
 	 	 (graph->deg[i] != 2) ) ||
 	       (g_options.heur_alg.visitflag == VISIT_RAND) ) )
@@ -488,11 +479,11 @@ calc_posa_heur_alg(
       fflush(g_options.log_fp);
     }
 
-    if (graphpath[nextvert].pathpos == -1)
+    if (graphpath.pathpos[nextvert] == -1)
     {
       plength++;
-      graphpath[nextvert].pathpos = plength-1;
-      graphpath[nextvert].ended = plength;
+      graphpath.pathpos[nextvert] = plength-1;
+      graphpath.ended[nextvert] = plength;
       path[pend].next = plength-1;
       pend = plength-1;
       path[plength-1].gvert = nextvert;
@@ -501,8 +492,8 @@ calc_posa_heur_alg(
     else
     {
       /* vertex is already in path, so do posa's transformation */
-      hc_reverse_path(path, graphpath, &pend,
-			graphpath[nextvert].pathpos, plength);
+      hc_reverse_path(path, &graphpath, &pend,
+			graphpath.pathpos[nextvert], plength);
     }
 
     /* check if have hamilitonian path, and if so, try to find a cycle */
@@ -532,11 +523,13 @@ calc_posa_heur_alg(
         /* smart cycle completion: check also if can use posa's
          * transformation to create a cycle.
          */
-        if (hc_path_to_cycle(graph, path, graphpath, &pstart, &pend, plength)
+        PHASE_START(PHASE_CLOSE);
+        if (hc_path_to_cycle(graph, path, &graphpath, &pstart, &pend, plength)
              == HC_FOUND)
         {
           found = 1;
         }
+        PHASE_STOP(PHASE_CLOSE);
       }
     }  /* end of hamiltonian path check */
         
@@ -574,7 +567,11 @@ master_heuristic_alg(
   int loop;
   int nodecount = 0;
   int prune = 0;
-  graph_type testgraph;
+  /* the scratch structures come from the trial's arena */
+  graph_type *testgraph = ARENA_NEW(graph_type);
+  graph_type *redgraph = ARENA_NEW(graph_type);
+  hc_reduce_type *reduce = ARENA_NEW(hc_reduce_type);
+  int reduced = 0;	/* 1 if the solution must be mapped back (reduce) */
 
   /* update statistics */
   trialstats->edgeprune = 0;
@@ -584,10 +581,14 @@ master_heuristic_alg(
   /* copy passed in graph to second graph data structure 
    * so that original graph isn't overwritten when pruning, etc.
    */
-  copy_graph(graph, &testgraph);
+  PHASE_START(PHASE_COPY);
+  copy_graph(graph, testgraph);
+  PHASE_STOP(PHASE_COPY);
 
   /* do initial H.C. pruning, and run tests to see if H.C. can exist */
-  ret = hc_do_pruning(&testgraph, &prune, HC_PRUNE_ALL, NULL);
+  PHASE_START(PHASE_INITPRUNE);
+  ret = hc_do_pruning(testgraph, &prune, HC_PRUNE_ALL, NULL);
+  PHASE_STOP(PHASE_INITPRUNE);
 
   /* update reduce statistic */
   trialstats->edgeprune = prune;
@@ -600,10 +601,45 @@ master_heuristic_alg(
    * construct the solution)
    */
 
+  /* contract forced chains, and work on the reduced graph instead */
+  if (g_options.heur_alg.contractflag == CONTRACT)
+  {
+    PHASE_START(PHASE_INITPRUNE);
+    hc_contract_chains(testgraph, redgraph, reduce);
+    PHASE_STOP(PHASE_INITPRUNE);
+    PHASE_START(PHASE_COPY);
+    copy_graph(redgraph, testgraph);
+    PHASE_STOP(PHASE_COPY);
+    reduced = 1;
+
+    if (g_options.report_flags & REPORT_ALG)
+    {
+      fprintf(g_options.log_fp, "Contracted %d forced chains, "
+	"searching %d of %d vertices.\n", reduce->numchains, reduce->numred,
+	reduce->numvert);
+    }
+  }
+
+  /* relabel the vertices for locality (on top of any contraction) */
+  if (g_options.heur_alg.relabelflag != RELABEL_NONE)
+  {
+    if (!reduced)
+      hc_init_reduce(reduce, testgraph->numvert);
+
+    PHASE_START(PHASE_INITPRUNE);
+    hc_relabel_graph(testgraph, redgraph, reduce, 
+	g_options.heur_alg.relabelflag);
+    PHASE_STOP(PHASE_INITPRUNE);
+    PHASE_START(PHASE_COPY);
+    copy_graph(redgraph, testgraph);
+    PHASE_STOP(PHASE_COPY);
+    reduced = 1;
+  }
+
   /* loop through each vertex in graph, using each one in turn as the
    * starting vertex
    */
-  for (loop = 0; loop < testgraph.numvert; loop++) 
+  for (loop = 0; loop < testgraph->numvert; loop++) 
   {
     if ( (g_options.report_flags & REPORT_ALG) && (VERBOSE_MODE) )
     {
@@ -614,15 +650,25 @@ master_heuristic_alg(
     
     if (g_options.algorithm == ALG_POSA_HEUR)
     {
-      ret = calc_posa_heur_alg(&testgraph, loop, solution, &nodecount);
+      PROGRESS_STORE(restart, loop);
+      PHASE_START(PHASE_SEARCH);
+      ret = calc_posa_heur_alg(testgraph, loop, solution, &nodecount);
+      PHASE_STOP(PHASE_SEARCH);
     }
 
     if (ret == HC_FOUND)
       break;
     if (ret == HC_NOT_EXIST)
       break;
+
+    /* the time limit is checked between starting vertices */
+    if (hc_check_timelimit() == HC_QUIT)
+      break;
   }
 
+  if ( (ret == HC_FOUND) && (reduced) )
+    hc_expand_solution(reduce, solution);
+
   /* update statistics */
   trialstats->retries = loop;
   trialstats->nodes = nodecount;
@@ -655,6 +701,9 @@ master_heuristic_alg(
  *  +smartcomplete : use smarts to convert hamiltonian line to a cycle.
  *  +cycleextend  : use cycleextend technique
  *     this requires and thus sets the  +smartvisit and +smartcomplete options
+ *  +contract  : contract forced chains after the initial pruning
+ *  +relabel=<none|bfs|rcm>  : relabel the vertices after the initial 
+ *     pruning (breadth first search or reverse cuthill-mckee order)
  *
  */
 int 
@@ -699,6 +748,32 @@ parse_heuristic_alg_options(
         g_options.heur_alg.visitflag = VISIT_SMART;
       }
 
+      /* contractflag parameter */
+      else if (strcasecmp(parmstr, "+contract")==0) 
+      {
+        g_options.heur_alg.contractflag = CONTRACT;
+      }
+      /* relabelflag parameter */
+      else if (strcasecmp(parmstr, "+relabel")==0) 
+      {
+        if (strcasecmp(valstr, "none")==0)
+        {
+          g_options.heur_alg.relabelflag = RELABEL_NONE;
+        }
+        else if (strcasecmp(valstr, "bfs")==0)
+        {
+          g_options.heur_alg.relabelflag = RELABEL_BFS;
+        }
+        else if (strcasecmp(valstr, "rcm")==0)
+        {
+          g_options.heur_alg.relabelflag = RELABEL_RCM;
+        }
+        else
+        {
+          EXIT_ERROR1("Error: invalid +relabel value `%s'.\n", valstr);
+        }
+      }
+
       else
       {
         WARN_ERROR1("Warning: Unidentified parameter `%s'.\n", parmstr);
@@ -730,6 +805,8 @@ init_heuristic_alg_options()
   g_options.heur_alg.completeflag = COMPLETE_NORM;
   g_options.heur_alg.visitflag = VISIT_RAND;
   g_options.heur_alg.cycleextendflag = NOCYCLEEXTEND;
+  g_options.heur_alg.contractflag = NOCONTRACT;
+  g_options.heur_alg.relabelflag = RELABEL_NONE;
 
 }  /* end of init_heuristic_alg_options() */
 
@@ -761,5 +838,19 @@ print_heuristic_alg_options(
   else if (g_options.heur_alg.cycleextendflag == NOCYCLEEXTEND)
     fprintf(fp, "no\n");
 
+  fprintf(fp, "    contract forced chains = ");
+  if (g_options.heur_alg.contractflag == CONTRACT)
+    fprintf(fp, "yes\n");
+  else
+    fprintf(fp, "no\n");
+
+  fprintf(fp, "    relabel vertices = ");
+  if (g_options.heur_alg.relabelflag == RELABEL_BFS)
+    fprintf(fp, "bfs order\n");
+  else if (g_options.heur_alg.relabelflag == RELABEL_RCM)
+    fprintf(fp, "reverse cuthill-mckee order\n");
+  else
+    fprintf(fp, "no\n");
+
 }  /* end of print_heuristic_alg_options() */
 
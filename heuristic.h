@@ -34,6 +34,8 @@ typedef struct {
   int visitflag;
   int completeflag;
   int cycleextendflag;
+  int contractflag;	/* = CONTRACT or NOCONTRACT */
+  int relabelflag;	/* = RELABEL_NONE, RELABEL_BFS or RELABEL_RCM */
 
 }  heuristic_alg_options_type;
 
@@ -0,0 +1,257 @@
+
+
+/* project includes */
+#include "main.h"
+
+#ifdef __linux__
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+
+/************************************************************/
+/* hardware performance counters (-report +hwcounters)
+ *
+ * the counters are opened as one perf_event group (led by the cycle
+ * counter) so that they are all counted over the same interval, and read
+ * with one read() call.  only user space is counted, which is allowed for
+ * unprivileged processes with the default perf_event_paranoid setting.
+ *
+ * if the group can't be opened (not linux, no perf support in a container
+ * or virtual machine, not permitted) a warning is given once and the
+ * counts are recorded as HW_NOCOUNT.  counters other than the cycles that
+ * the hardware doesn't have are left out of the group.
+ */
+/************************************************************/
+
+int g_hwstate = HWC_CLOSED;
+
+#ifdef __linux__
+
+/* file descriptor of each counter (-1 if not in the group), and its
+ * position in the group read
+ */
+int g_hwfd[NUM_HWCOUNTERS];
+int g_hwpos[NUM_HWCOUNTERS];
+int g_hwnum = 0;
+
+/* event type and config of each counter */
+struct {
+  unsigned int type;
+  unsigned long long config;
+}  g_hwevent[NUM_HWCOUNTERS] = {
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+  { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+	(PERF_COUNT_HW_CACHE_OP_READ << 8) |
+	(PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES } };
+
+
+/************************************************************/
+/* this function opens the counter group.  sets g_hwstate to HWC_OPEN
+ * or HWC_UNAVAIL
+ */
+void
+hw_counters_open()
+{
+  struct perf_event_attr attr;
+  int loop;
+  int leader = -1;
+
+  g_hwnum = 0;
+  for (loop = 0; loop < NUM_HWCOUNTERS; loop++)
+  {
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = g_hwevent[loop].type;
+    attr.config = g_hwevent[loop].config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+			PERF_FORMAT_TOTAL_TIME_RUNNING;
+    /* the group is started and stopped through the leader */
+    attr.disabled = (leader == -1) ? 1 : 0;
+
+    g_hwfd[loop] = syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0);
+    if (g_hwfd[loop] < 0)
+    {
+      g_hwfd[loop] = -1;
+      if (leader == -1)
+      {
+        fprintf(stderr, "Warning:  hardware counters not available (%s), "
+		"not recorded.\n", strerror(errno));
+        g_hwstate = HWC_UNAVAIL;
+        return;
+      }
+      continue;
+    }
+
+    if (leader == -1)
+      leader = g_hwfd[loop];
+    g_hwpos[loop] = g_hwnum++;
+  }
+
+  g_hwstate = HWC_OPEN;
+
+}  /* end of hw_counters_open() */
+
+#endif  /* __linux__ */
+
+
+/************************************************************/
+/* this function resets and starts the counters for a trial (opening the
+ * group the first time)
+ */
+void
+hw_counters_start()
+{
+  if (g_hwstate == HWC_CLOSED)
+  {
+#ifdef __linux__
+    hw_counters_open();
+#else
+    WARN_ERROR("Warning:  hardware counters are only supported on linux, "
+		"not recorded.\n");
+    g_hwstate = HWC_UNAVAIL;
+#endif
+  }
+
+#ifdef __linux__
+  if (g_hwstate == HWC_OPEN)
+  {
+    ioctl(g_hwfd[HW_CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(g_hwfd[HW_CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+#endif
+
+}  /* end of hw_counters_start() */
+
+
+/************************************************************/
+/* this function stops the counters, and records the counts of the trial.
+ * if the group was multiplexed with other events, the counts are scaled
+ * up to the whole trial
+ */
+void
+hw_counters_stop(
+  stat_pertrial_type *trialstats)
+{
+  int loop;
+
+  for (loop = 0; loop < NUM_HWCOUNTERS; loop++)
+    trialstats->hwcount[loop] = HW_NOCOUNT;
+
+#ifdef __linux__
+  if (g_hwstate == HWC_OPEN)
+  {
+    /* group read format:  nr, time enabled, time running, values[nr] */
+    unsigned long long buf[3 + NUM_HWCOUNTERS];
+    double scale = 1.0;
+
+    ioctl(g_hwfd[HW_CYCLES], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    if (read(g_hwfd[HW_CYCLES], buf, sizeof(buf)) <
+		(long) ((3 + g_hwnum) * sizeof(buf[0])) )
+      return;
+
+    /* never scheduled on the cpu */
+    if (buf[2] == 0)
+      return;
+
+    if (buf[2] < buf[1])
+      scale = (double) buf[1] / (double) buf[2];
+
+    for (loop = 0; loop < NUM_HWCOUNTERS; loop++)
+    {
+      if (g_hwfd[loop] != -1)
+        trialstats->hwcount[loop] = (long long) (buf[3 + g_hwpos[loop]] * scale);
+    }
+  }
+#endif
+
+}  /* end of hw_counters_stop() */
+
+
+/************************************************************/
+/* this function closes the counter group */
+void
+hw_counters_close()
+{
+#ifdef __linux__
+  int loop;
+
+  if (g_hwstate == HWC_OPEN)
+  {
+    for (loop = NUM_HWCOUNTERS - 1; loop >= 0; loop--)
+    {
+      if (g_hwfd[loop] != -1)
+        close(g_hwfd[loop]);
+    }
+  }
+#endif
+
+  g_hwstate = HWC_CLOSED;
+
+}  /* end of hw_counters_close() */
+
+
+/************************************************************/
+/* this function prints the counts of a trial (to the log file) */
+void
+print_hw_counters(
+  FILE *fp,
+  stat_pertrial_type *trialstats)
+{
+  int loop;
+
+  if (trialstats->hwcount[HW_CYCLES] == HW_NOCOUNT)
+    return;
+
+  fprintf(fp, "Hardware counters:");
+  for (loop = 0; loop < NUM_HWCOUNTERS; loop++)
+  {
+    if (trialstats->hwcount[loop] == HW_NOCOUNT)
+      fprintf(fp, "  %s n/a", hwcounter_str[loop]);
+    else
+      fprintf(fp, "  %s %lld", hwcounter_str[loop], trialstats->hwcount[loop]);
+  }
+  fprintf(fp, "\n");
+
+}  /* end of print_hw_counters() */
+
+
+/************************************************************/
+/* this function prints the instructions per cycle and the misses per node
+ * of a trial, as tab separated columns for the stats file.  "-" is 
+ * printed for counts that aren't available
+ */
+void
+print_trial_hw_stats(
+  FILE *fp,
+  stat_pertrial_type *trialstats)
+{
+  int loop;
+  float nodes = (trialstats->nodes > 0) ? (float) trialstats->nodes : 1.0;
+
+  if ( (trialstats->hwcount[HW_CYCLES] <= 0) || 
+       (trialstats->hwcount[HW_INSTR] == HW_NOCOUNT) )
+    fprintf(fp, "\t-");
+  else
+    fprintf(fp, "\t%.2f", (float) trialstats->hwcount[HW_INSTR] / 
+			(float) trialstats->hwcount[HW_CYCLES]);
+
+  for (loop = HW_L1MISS; loop <= HW_BRMISS; loop++)
+  {
+    if (trialstats->hwcount[loop] == HW_NOCOUNT)
+      fprintf(fp, "\t-");
+    else
+      fprintf(fp, "\t%.1f", trialstats->hwcount[loop] / nodes);
+  }
+
+}  /* end of print_trial_hw_stats() */
+
@@ -0,0 +1,32 @@
+
+
+#ifndef _HWCOUNT_H_
+#define _HWCOUNT_H_
+
+
+/************************************************************/
+/* defines and data structures */
+/************************************************************/
+
+/* state of the counter group */
+#define HWC_CLOSED	0	/* not opened yet */
+#define HWC_OPEN	1
+#define HWC_UNAVAIL	2	/* could not be opened, counts not recorded */
+
+
+/************************************************************/
+/* function declarations */
+/************************************************************/
+
+void hw_counters_start();
+
+void hw_counters_stop( stat_pertrial_type *trialstats);
+
+void hw_counters_close();
+
+void print_hw_counters( FILE *fp, stat_pertrial_type *trialstats);
+
+void print_trial_hw_stats( FILE *fp, stat_pertrial_type *trialstats);
+
+#endif /* _HWCOUNT_H_ */
+
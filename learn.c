@@ -0,0 +1,1634 @@
+
+/* project includes */
+#include "main.h"
+
+
+/************************************************************/
+/* conflict driven learning search (-algorithm learn)
+ *
+ * each edge of the (pruned) graph is a boolean variable, true if the
+ * edge is in the cycle.  the constraints are
+ *
+ *   - each vertex has exactly 2 true edges (checked directly on the
+ *     counts of true and false edges of each vertex, not as clauses)
+ *   - the true edges have no cycle shorter than the graph (the ends of
+ *     each path of true edges are kept, so the edge joining them is set
+ *     false as soon as the path is made)
+ *   - every cut of the graph is crossed by the cycle:  when the edges
+ *     that aren't false leave the graph disconnected, or with a cut
+ *     vertex, a clause saying one of the false edges across the cut is
+ *     true is added (a subtour elimination constraint, generated only
+ *     when it is violated)
+ *
+ * the search decides an edge, propagates, and on a conflict learns a
+ * clause (first unique implication point) and jumps back, as a cdcl sat
+ * solver does.  the clauses behind the degree and path propagations are
+ * only built when a conflict needs them.  the decisions follow the edge
+ * activities (vsids), the values last given to the edges are reused,
+ * and the search restarts on a luby schedule.  a search that finishes
+ * without finding a cycle proves there is none.
+ */
+/************************************************************/
+
+/* literals:  2*var if the edge var is in the cycle, 2*var+1 if not */
+#define LIT_POS(var)	((var) << 1)
+#define LIT_NEG(var)	(((var) << 1) | 1)
+#define LIT_VAR(lit)	((lit) >> 1)
+#define LIT_NOT(lit)	((lit) ^ 1)
+
+/* values of the edge variables */
+#define VAL_FALSE	0
+#define VAL_TRUE	1
+#define VAL_UNDEF	2
+
+#define LIT_VALUE(lit) ( (g_learn.value[LIT_VAR(lit)] == VAL_UNDEF) ? \
+	VAL_UNDEF : (g_learn.value[LIT_VAR(lit)] ^ ((lit) & 1)) )
+
+/* why an edge has its value, or what the conflict is */
+#define WHY_DECISION	0	/* decided (or set at level 0) */
+#define WHY_CLAUSE	1	/* clause # data */
+#define WHY_DEGREE	2	/* degree 2 constraint of vertex data */
+#define WHY_PATH	3	/* the edge would close a short cycle */
+#define WHY_CYCLE	4	/* conflict:  edge data closed a short cycle */
+#define WHY_CUT		5	/* conflict:  cut clause is in g_learn.lits */
+
+/* return values of the propagation functions */
+#define LEARN_OK	0
+#define LEARN_CONFLICT	1
+
+typedef struct {
+  int *lits;		/* lits[0] and lits[1] are watched */
+  int size;
+  float act;
+  int learnt;		/* 0 for the cut clauses, which are kept */
+  }  learn_clause_type;
+
+typedef struct {
+  int *data;
+  int num;
+  int max;
+  }  learn_vec_type;
+
+typedef struct {
+  graph_type *graph;
+  int numvert;
+  int numvar;
+
+  /* edges */
+  int *var;		/* var of edge (v, nbr[v][k]) at [v*MAXDEGREE + k] */
+  int *end1, *end2;	/* the vertices of each edge */
+
+  /* assignment */
+  char *value;
+  char *phase;		/* value to decide an edge to */
+  char *why;
+  int *whydata;
+  int *level;
+  int *trailpos;
+  int *trail;
+  int trailnum;
+  int qhead;		/* next trail entry to propagate */
+  int *trail_lim;	/* trail position where each level starts */
+  int numlevel;
+
+  /* vertices:  counts of true and false edges, the true edges (a third
+   * is only there till the conflict is seen), and for the ends of the
+   * paths of true edges, the other end and the # of vertices
+   */
+  int *ntrue, *nfalse;
+  int *tvar;		/* [3*v + i] */
+  int *pend, *plen;
+
+  /* what joining two paths with each true edge changed (for undoing) */
+  char *joined;
+  int *joinend1, *joinend2;
+  int *joinlen1, *joinlen2;
+
+  /* clauses, and the clauses watching each literal */
+  learn_clause_type *clause;
+  int numclause;
+  int maxclause;
+  int numlearnt;
+  int maxlearn;
+  learn_vec_type *watch;
+  float clainc;
+
+  /* decision order:  heap of edges by activity */
+  double *act;
+  double varinc;
+  int *heap;
+  int *heappos;		/* -1 if not in the heap */
+  int heapnum;
+
+  /* conflict */
+  int conflict;		/* WHY_* */
+  int conflictdata;
+  int found;		/* 1 once the true edges are a hamiltonian cycle */
+
+  /* scratch */
+  int *lits;
+  int numlits;
+  int *learnlits;
+  char *seen;
+  int *disc, *low, *size, *parent;
+  int dfstime;
+
+  /* statistics */
+  int decisions;
+  int conflicts;
+  int restarts;
+  int numcuts;
+  int totlearnt;
+  }  learn_type;
+
+learn_type g_learn;
+
+
+/************************************************************/
+/* this function adds x to the end of a vector */
+void
+learn_vec_push(
+  learn_vec_type *vec,
+  int x)
+{
+  if (vec->num == vec->max)
+  {
+    vec->max = (vec->max == 0) ? 4 : 2 * vec->max;
+    vec->data = (int *) realloc(vec->data, vec->max * sizeof(int));
+    if (vec->data == NULL)
+    {
+      EXIT_ERROR("Error: out of memory for the learning search.\n");
+    }
+  }
+  vec->data[vec->num++] = x;
+
+}  /* end of learn_vec_push() */
+
+
+/************************************************************/
+/* decision heap functions:  the heap is ordered by edge activity (the
+ * most active edge on top)
+ */
+void
+learn_heap_up(
+  int i)
+{
+  int var = g_learn.heap[i];
+  int parent;
+
+  while (i > 0)
+  {
+    parent = (i - 1) / 2;
+    if (g_learn.act[g_learn.heap[parent]] >= g_learn.act[var])
+      break;
+    g_learn.heap[i] = g_learn.heap[parent];
+    g_learn.heappos[g_learn.heap[i]] = i;
+    i = parent;
+  }
+  g_learn.heap[i] = var;
+  g_learn.heappos[var] = i;
+
+}  /* end of learn_heap_up() */
+
+
+void
+learn_heap_down(
+  int i)
+{
+  int var = g_learn.heap[i];
+  int child;
+
+  while (1)
+  {
+    child = 2 * i + 1;
+    if (child >= g_learn.heapnum)
+      break;
+    if ( (child + 1 < g_learn.heapnum) &&
+	 (g_learn.act[g_learn.heap[child+1]] > g_learn.act[g_learn.heap[child]]) )
+      child++;
+    if (g_learn.act[g_learn.heap[child]] <= g_learn.act[var])
+      break;
+    g_learn.heap[i] = g_learn.heap[child];
+    g_learn.heappos[g_learn.heap[i]] = i;
+    i = child;
+  }
+  g_learn.heap[i] = var;
+  g_learn.heappos[var] = i;
+
+}  /* end of learn_heap_down() */
+
+
+void
+learn_heap_insert(
+  int var)
+{
+  if (g_learn.heappos[var] >= 0)
+    return;
+
+  g_learn.heap[g_learn.heapnum] = var;
+  g_learn.heappos[var] = g_learn.heapnum;
+  g_learn.heapnum++;
+  learn_heap_up(g_learn.heapnum - 1);
+
+}  /* end of learn_heap_insert() */
+
+
+int
+learn_heap_pop()
+{
+  int var = g_learn.heap[0];
+
+  g_learn.heapnum--;
+  g_learn.heappos[var] = -1;
+  if (g_learn.heapnum > 0)
+  {
+    g_learn.heap[0] = g_learn.heap[g_learn.heapnum];
+    g_learn.heappos[g_learn.heap[0]] = 0;
+    learn_heap_down(0);
+  }
+
+  return(var);
+
+}  /* end of learn_heap_pop() */
+
+
+/************************************************************/
+/* this function bumps the activity of an edge that took part in a
+ * conflict
+ */
+void
+learn_bump_var(
+  int var)
+{
+  int loop;
+
+  g_learn.act[var] += g_learn.varinc;
+  if (g_learn.act[var] > 1e100)
+  {
+    for (loop = 0; loop < g_learn.numvar; loop++)
+      g_learn.act[loop] *= 1e-100;
+    g_learn.varinc *= 1e-100;
+  }
+
+  if (g_learn.heappos[var] >= 0)
+    learn_heap_up(g_learn.heappos[var]);
+
+}  /* end of learn_bump_var() */
+
+
+/************************************************************/
+/* this function bumps the activity of a learned clause that took part
+ * in a conflict
+ */
+void
+learn_bump_clause(
+  int ci)
+{
+  int loop;
+
+  if (!g_learn.clause[ci].learnt)
+    return;
+
+  g_learn.clause[ci].act += g_learn.clainc;
+  if (g_learn.clause[ci].act > 1e20)
+  {
+    for (loop = 0; loop < g_learn.numclause; loop++)
+      g_learn.clause[loop].act *= 1e-20;
+    g_learn.clainc *= 1e-20;
+  }
+
+}  /* end of learn_bump_clause() */
+
+
+/************************************************************/
+/* this function returns the variable of the edge (a,b), or -1 if there
+ * is no such edge
+ */
+int
+learn_edge_var(
+  int a,
+  int b)
+{
+  int loop;
+
+  for (loop = 0; loop < g_learn.graph->deg[a]; loop++)
+  {
+    if (g_learn.graph->nbr[a][loop] == b)
+      return(g_learn.var[a * MAXDEGREE + loop]);
+  }
+
+  return(-1);
+
+}  /* end of learn_edge_var() */
+
+
+/************************************************************/
+/* this function records a conflict, and returns LEARN_CONFLICT */
+int
+learn_set_conflict(
+  int why,
+  int data)
+{
+  g_learn.conflict = why;
+  g_learn.conflictdata = data;
+
+  return(LEARN_CONFLICT);
+
+}  /* end of learn_set_conflict() */
+
+
+/************************************************************/
+/* this function gives literal lit its value (at the current level),
+ * and updates the edge counts and paths of its vertices.
+ * returns LEARN_CONFLICT if that breaks a degree constraint or closes a
+ * short cycle, LEARN_OK otherwise.  (g_learn.found is set if it closes
+ * a hamiltonian cycle)
+ */
+int
+learn_assign(
+  int lit,
+  int why,
+  int whydata)
+{
+  int var = LIT_VAR(lit);
+  int a = g_learn.end1[var];
+  int b = g_learn.end2[var];
+  int ea, eb;
+
+  g_learn.value[var] = (lit & 1) ? VAL_FALSE : VAL_TRUE;
+  g_learn.why[var] = why;
+  g_learn.whydata[var] = whydata;
+  g_learn.level[var] = g_learn.numlevel;
+  g_learn.trailpos[var] = g_learn.trailnum;
+  g_learn.trail[g_learn.trailnum++] = lit;
+  g_learn.joined[var] = 0;
+
+  if (g_learn.value[var] == VAL_FALSE)
+  {
+    g_learn.nfalse[a]++;
+    g_learn.nfalse[b]++;
+    if (g_learn.graph->deg[a] - g_learn.nfalse[a] < 2)
+      return(learn_set_conflict(WHY_DEGREE, a));
+    if (g_learn.graph->deg[b] - g_learn.nfalse[b] < 2)
+      return(learn_set_conflict(WHY_DEGREE, b));
+    return(LEARN_OK);
+  }
+
+  g_learn.tvar[3 * a + g_learn.ntrue[a]++] = var;
+  g_learn.tvar[3 * b + g_learn.ntrue[b]++] = var;
+  if (g_learn.ntrue[a] > 2)
+    return(learn_set_conflict(WHY_DEGREE, a));
+  if (g_learn.ntrue[b] > 2)
+    return(learn_set_conflict(WHY_DEGREE, b));
+
+  /* a and b are ends of paths:  the same path closes into a cycle */
+  if (g_learn.pend[a] == b)
+  {
+    if (g_learn.plen[a] == g_learn.numvert)
+    {
+      g_learn.found = 1;
+      return(LEARN_OK);
+    }
+    return(learn_set_conflict(WHY_CYCLE, var));
+  }
+
+  /* else join the two paths */
+  ea = g_learn.pend[a];
+  eb = g_learn.pend[b];
+  g_learn.joined[var] = 1;
+  g_learn.joinend1[var] = ea;
+  g_learn.joinend2[var] = eb;
+  g_learn.joinlen1[var] = g_learn.plen[a];
+  g_learn.joinlen2[var] = g_learn.plen[b];
+
+  g_learn.plen[ea] = g_learn.plen[eb] = g_learn.plen[a] + g_learn.plen[b];
+  g_learn.pend[ea] = eb;
+  g_learn.pend[eb] = ea;
+
+  return(LEARN_OK);
+
+}  /* end of learn_assign() */
+
+
+/************************************************************/
+/* this function undoes the assignments above the specified level */
+void
+learn_backtrack(
+  int tolevel)
+{
+  int loop;
+  int var;
+  int a, b;
+
+  if (g_learn.numlevel <= tolevel)
+    return;
+
+  for (loop = g_learn.trailnum - 1; loop >= g_learn.trail_lim[tolevel];
+       loop--)
+  {
+    var = LIT_VAR(g_learn.trail[loop]);
+    a = g_learn.end1[var];
+    b = g_learn.end2[var];
+
+    if (g_learn.value[var] == VAL_TRUE)
+    {
+      if (g_learn.joined[var])
+      {
+        g_learn.pend[g_learn.joinend1[var]] = a;
+        g_learn.pend[g_learn.joinend2[var]] = b;
+        g_learn.plen[g_learn.joinend1[var]] = g_learn.joinlen1[var];
+        g_learn.plen[g_learn.joinend2[var]] = g_learn.joinlen2[var];
+      }
+      g_learn.ntrue[a]--;
+      g_learn.ntrue[b]--;
+    }
+    else
+    {
+      g_learn.nfalse[a]--;
+      g_learn.nfalse[b]--;
+    }
+
+    g_learn.phase[var] = g_learn.value[var];
+    g_learn.value[var] = VAL_UNDEF;
+    learn_heap_insert(var);
+  }
+
+  g_learn.trailnum = g_learn.trail_lim[tolevel];
+  g_learn.qhead = g_learn.trailnum;
+  g_learn.numlevel = tolevel;
+
+}  /* end of learn_backtrack() */
+
+
+/************************************************************/
+/* this function propagates the degree constraint of vertex x:  with 2
+ * true edges the others are false, and with only 2 edges left that
+ * aren't false they are both true
+ */
+int
+learn_prop_vertex(
+  int x)
+{
+  int loop;
+  int var;
+  int deg = g_learn.graph->deg[x];
+
+  if (g_learn.ntrue[x] + g_learn.nfalse[x] == deg)
+    return(LEARN_OK);
+
+  if (g_learn.ntrue[x] == 2)
+  {
+    for (loop = 0; loop < deg; loop++)
+    {
+      var = g_learn.var[x * MAXDEGREE + loop];
+      if ( (g_learn.value[var] == VAL_UNDEF) &&
+	   (learn_assign(LIT_NEG(var), WHY_DEGREE, x) == LEARN_CONFLICT) )
+        return(LEARN_CONFLICT);
+    }
+  }
+  else if (deg - g_learn.nfalse[x] == 2)
+  {
+    for (loop = 0; loop < deg; loop++)
+    {
+      var = g_learn.var[x * MAXDEGREE + loop];
+      if ( (g_learn.value[var] == VAL_UNDEF) &&
+	   (learn_assign(LIT_POS(var), WHY_DEGREE, x) == LEARN_CONFLICT) )
+        return(LEARN_CONFLICT);
+      if (g_learn.found)
+        return(LEARN_OK);
+    }
+  }
+
+  return(LEARN_OK);
+
+}  /* end of learn_prop_vertex() */
+
+
+/************************************************************/
+/* this function visits the clauses watching literal falselit (which
+ * has just been made false), moving the watch to another literal that
+ * isn't false, or else propagating or reporting the conflict
+ */
+int
+learn_prop_clauses(
+  int falselit)
+{
+  learn_vec_type *vec = &g_learn.watch[falselit];
+  learn_clause_type *cl;
+  int i, j, k;
+  int ci;
+  int tmp;
+  int ret = LEARN_OK;
+
+  for (i = j = 0; i < vec->num; )
+  {
+    ci = vec->data[i++];
+    cl = &g_learn.clause[ci];
+
+    if (cl->lits[0] == falselit)
+    {
+      cl->lits[0] = cl->lits[1];
+      cl->lits[1] = falselit;
+    }
+
+    if (LIT_VALUE(cl->lits[0]) == VAL_TRUE)
+    {
+      vec->data[j++] = ci;
+      continue;
+    }
+
+    for (k = 2; k < cl->size; k++)
+    {
+      if (LIT_VALUE(cl->lits[k]) != VAL_FALSE)
+        break;
+    }
+    if (k < cl->size)
+    {
+      tmp = cl->lits[1];
+      cl->lits[1] = cl->lits[k];
+      cl->lits[k] = tmp;
+      learn_vec_push(&g_learn.watch[cl->lits[1]], ci);
+      continue;
+    }
+
+    /* unit or conflicting */
+    vec->data[j++] = ci;
+    if (LIT_VALUE(cl->lits[0]) == VAL_FALSE)
+      ret = learn_set_conflict(WHY_CLAUSE, ci);
+    else
+      ret = learn_assign(cl->lits[0], WHY_CLAUSE, ci);
+
+    if ( (ret == LEARN_CONFLICT) || (g_learn.found) )
+    {
+      while (i < vec->num)
+        vec->data[j++] = vec->data[i++];
+      break;
+    }
+  }
+  vec->num = j;
+
+  return(ret);
+
+}  /* end of learn_prop_clauses() */
+
+
+/************************************************************/
+/* this function propagates the assignments on the trail that haven't
+ * been yet.  returns LEARN_CONFLICT (with g_learn.conflict set) or
+ * LEARN_OK
+ */
+int
+learn_propagate()
+{
+  int lit, var;
+  int a, b;
+  int shortvar;
+
+  while ( (g_learn.qhead < g_learn.trailnum) && (!g_learn.found) )
+  {
+    lit = g_learn.trail[g_learn.qhead++];
+    var = LIT_VAR(lit);
+
+    if (learn_prop_clauses(LIT_NOT(lit)) == LEARN_CONFLICT)
+      return(LEARN_CONFLICT);
+    if (g_learn.found)
+      break;
+
+    if (learn_prop_vertex(g_learn.end1[var]) == LEARN_CONFLICT)
+      return(LEARN_CONFLICT);
+    if (learn_prop_vertex(g_learn.end2[var]) == LEARN_CONFLICT)
+      return(LEARN_CONFLICT);
+    if (g_learn.found)
+      break;
+
+    /* the edge joining the ends of the new path would close a short
+     * cycle (if they are still its ends)
+     */
+    if (g_learn.joined[var])
+    {
+      a = g_learn.joinend1[var];
+      b = g_learn.joinend2[var];
+      if ( (g_learn.pend[a] == b) && (g_learn.plen[a] < g_learn.numvert) )
+      {
+        shortvar = learn_edge_var(a, b);
+        if ( (shortvar >= 0) && (g_learn.value[shortvar] == VAL_UNDEF) &&
+	     (learn_assign(LIT_NEG(shortvar), WHY_PATH, 0) == LEARN_CONFLICT) )
+          return(LEARN_CONFLICT);
+      }
+    }
+  }
+
+  return(LEARN_OK);
+
+}  /* end of learn_propagate() */
+
+
+/************************************************************/
+/* this function adds to g_learn.lits the negations of the true edges
+ * of the path from vertex from to vertex to, using only the edges set
+ * before trail position limit
+ */
+void
+learn_add_path_lits(
+  int from,
+  int to,
+  int limit)
+{
+  int prev = -1;
+  int cur = from;
+  int next = -1;
+  int var = -1;
+  int loop;
+
+  while (cur != to)
+  {
+    for (loop = 0; loop < g_learn.ntrue[cur]; loop++)
+    {
+      var = g_learn.tvar[3 * cur + loop];
+      if (g_learn.trailpos[var] >= limit)
+        continue;
+      next = (g_learn.end1[var] == cur) ? g_learn.end2[var] :
+		g_learn.end1[var];
+      if (next != prev)
+        break;
+    }
+    if (loop == g_learn.ntrue[cur])
+    {
+      EXIT_ERROR("Error: broken path in the learning search.\n");
+    }
+
+    g_learn.lits[g_learn.numlits++] = LIT_NEG(var);
+    prev = cur;
+    cur = next;
+  }
+
+}  /* end of learn_add_path_lits() */
+
+
+/************************************************************/
+/* this function puts in g_learn.lits the (false) literals of the clause
+ * that implied the value of var (all but var's own literal)
+ */
+void
+learn_reason_lits(
+  int var)
+{
+  learn_clause_type *cl;
+  int x = g_learn.whydata[var];
+  int limit = g_learn.trailpos[var];
+  int loop;
+  int evar;
+
+  g_learn.numlits = 0;
+
+  switch (g_learn.why[var])
+  {
+    case WHY_CLAUSE:
+      cl = &g_learn.clause[x];
+      learn_bump_clause(x);
+      for (loop = 0; loop < cl->size; loop++)
+      {
+        if (LIT_VAR(cl->lits[loop]) != var)
+          g_learn.lits[g_learn.numlits++] = cl->lits[loop];
+      }
+      break;
+
+    case WHY_DEGREE:
+      if (g_learn.value[var] == VAL_FALSE)
+      {
+        /* the 2 true edges of x */
+        for (loop = 0; loop < g_learn.ntrue[x]; loop++)
+        {
+          evar = g_learn.tvar[3 * x + loop];
+          if (g_learn.trailpos[evar] < limit)
+            g_learn.lits[g_learn.numlits++] = LIT_NEG(evar);
+        }
+      }
+      else
+      {
+        /* the false edges of x */
+        for (loop = 0; loop < g_learn.graph->deg[x]; loop++)
+        {
+          evar = g_learn.var[x * MAXDEGREE + loop];
+          if ( (g_learn.value[evar] == VAL_FALSE) &&
+	       (g_learn.trailpos[evar] < limit) )
+            g_learn.lits[g_learn.numlits++] = LIT_POS(evar);
+        }
+      }
+      break;
+
+    case WHY_PATH:
+      learn_add_path_lits(g_learn.end1[var], g_learn.end2[var], limit);
+      break;
+  }
+
+}  /* end of learn_reason_lits() */
+
+
+/************************************************************/
+/* this function puts in g_learn.lits the (all false) literals of the
+ * clause broken by the conflict
+ */
+void
+learn_conflict_lits()
+{
+  learn_clause_type *cl;
+  int x = g_learn.conflictdata;
+  int loop;
+  int evar;
+
+  if (g_learn.conflict == WHY_CUT)
+    return;
+
+  g_learn.numlits = 0;
+
+  switch (g_learn.conflict)
+  {
+    case WHY_CLAUSE:
+      cl = &g_learn.clause[x];
+      learn_bump_clause(x);
+      for (loop = 0; loop < cl->size; loop++)
+        g_learn.lits[g_learn.numlits++] = cl->lits[loop];
+      break;
+
+    case WHY_DEGREE:
+      if (g_learn.ntrue[x] > 2)
+      {
+        for (loop = 0; loop < g_learn.ntrue[x]; loop++)
+          g_learn.lits[g_learn.numlits++] = LIT_NEG(g_learn.tvar[3*x + loop]);
+      }
+      else
+      {
+        for (loop = 0; loop < g_learn.graph->deg[x]; loop++)
+        {
+          evar = g_learn.var[x * MAXDEGREE + loop];
+          if (g_learn.value[evar] == VAL_FALSE)
+            g_learn.lits[g_learn.numlits++] = LIT_POS(evar);
+        }
+      }
+      break;
+
+    case WHY_CYCLE:
+      g_learn.lits[g_learn.numlits++] = LIT_NEG(x);
+      learn_add_path_lits(g_learn.end1[x], g_learn.end2[x],
+		g_learn.trailpos[x]);
+      break;
+  }
+
+}  /* end of learn_conflict_lits() */
+
+
+/************************************************************/
+/* this function adds a clause (of at least 2 literals) to the clause
+ * list, watching its first 2 literals.  returns the clause #
+ */
+int
+learn_add_clause(
+  int lits[],
+  int size,
+  int learnt)
+{
+  learn_clause_type *cl;
+
+  if (g_learn.numclause == g_learn.maxclause)
+  {
+    g_learn.maxclause = (g_learn.maxclause == 0) ? 1024 :
+		2 * g_learn.maxclause;
+    g_learn.clause = (learn_clause_type *) realloc(g_learn.clause,
+		g_learn.maxclause * sizeof(learn_clause_type));
+    if (g_learn.clause == NULL)
+    {
+      EXIT_ERROR("Error: out of memory for the learning search.\n");
+    }
+  }
+
+  cl = &g_learn.clause[g_learn.numclause];
+  cl->lits = (int *) malloc(size * sizeof(int));
+  if (cl->lits == NULL)
+  {
+    EXIT_ERROR("Error: out of memory for the learning search.\n");
+  }
+  memcpy(cl->lits, lits, size * sizeof(int));
+  cl->size = size;
+  cl->act = 0.0;
+  cl->learnt = learnt;
+
+  learn_vec_push(&g_learn.watch[lits[0]], g_learn.numclause);
+  learn_vec_push(&g_learn.watch[lits[1]], g_learn.numclause);
+
+  if (learnt)
+  {
+    g_learn.numlearnt++;
+    g_learn.totlearnt++;
+  }
+
+  return(g_learn.numclause++);
+
+}  /* end of learn_add_clause() */
+
+
+/************************************************************/
+/* compares the activities of two learned clauses (by clause #), for
+ * qsort()
+ */
+int
+learn_act_cmp(
+  const void *x,
+  const void *y)
+{
+  float ax = g_learn.clause[*(int *) x].act;
+  float ay = g_learn.clause[*(int *) y].act;
+
+  if (ax < ay)
+    return(-1);
+  if (ax > ay)
+    return(1);
+  return(0);
+
+}  /* end of learn_act_cmp() */
+
+
+/************************************************************/
+/* this function drops the less active half of the learned clauses
+ * (except binary ones, and those that are the reason for a value), and
+ * rebuilds the watch lists
+ */
+void
+learn_reduce()
+{
+  int *order;
+  int *newnum;
+  int numorder = 0;
+  int loop, ci;
+  int var;
+  learn_clause_type *cl;
+
+  order = (int *) malloc(g_learn.numclause * sizeof(int));
+  newnum = (int *) malloc(g_learn.numclause * sizeof(int));
+  if ( (order == NULL) || (newnum == NULL) )
+  {
+    EXIT_ERROR("Error: out of memory for the learning search.\n");
+  }
+
+  for (ci = 0; ci < g_learn.numclause; ci++)
+  {
+    if (g_learn.clause[ci].learnt)
+      order[numorder++] = ci;
+  }
+  qsort(order, numorder, sizeof(int), learn_act_cmp);
+
+  for (loop = 0; loop < numorder / 2; loop++)
+  {
+    cl = &g_learn.clause[order[loop]];
+    var = LIT_VAR(cl->lits[0]);
+    if ( (cl->size <= 2) ||
+	 ( (g_learn.value[var] != VAL_UNDEF) &&
+	   (g_learn.why[var] == WHY_CLAUSE) &&
+	   (g_learn.whydata[var] == order[loop]) ) )
+      continue;
+
+    free(cl->lits);
+    cl->lits = NULL;
+    g_learn.numlearnt--;
+  }
+
+  /* close up the clause list */
+  for (ci = loop = 0; ci < g_learn.numclause; ci++)
+  {
+    if (g_learn.clause[ci].lits == NULL)
+      continue;
+    newnum[ci] = loop;
+    g_learn.clause[loop++] = g_learn.clause[ci];
+  }
+  g_learn.numclause = loop;
+
+  for (var = 0; var < g_learn.numvar; var++)
+  {
+    if ( (g_learn.value[var] != VAL_UNDEF) &&
+	 (g_learn.why[var] == WHY_CLAUSE) )
+      g_learn.whydata[var] = newnum[g_learn.whydata[var]];
+  }
+
+  for (loop = 0; loop < 2 * g_learn.numvar; loop++)
+    g_learn.watch[loop].num = 0;
+  for (ci = 0; ci < g_learn.numclause; ci++)
+  {
+    learn_vec_push(&g_learn.watch[g_learn.clause[ci].lits[0]], ci);
+    learn_vec_push(&g_learn.watch[g_learn.clause[ci].lits[1]], ci);
+  }
+
+  g_learn.maxlearn += g_learn.maxlearn / 10;
+
+  free(order);
+  free(newnum);
+
+}  /* end of learn_reduce() */
+
+
+/************************************************************/
+/* depth first search over the edges that aren't false, for
+ * learn_check_cuts()
+ */
+void
+learn_cut_dfs(
+  int v)
+{
+  int loop;
+  int var;
+  int w;
+
+  g_learn.disc[v] = g_learn.low[v] = ++g_learn.dfstime;
+  g_learn.size[v] = 1;
+
+  for (loop = 0; loop < g_learn.graph->deg[v]; loop++)
+  {
+    var = g_learn.var[v * MAXDEGREE + loop];
+    if (g_learn.value[var] == VAL_FALSE)
+      continue;
+
+    w = g_learn.graph->nbr[v][loop];
+    if (g_learn.disc[w] == 0)
+    {
+      g_learn.parent[w] = v;
+      learn_cut_dfs(w);
+      g_learn.size[v] += g_learn.size[w];
+      if (g_learn.low[w] < g_learn.low[v])
+        g_learn.low[v] = g_learn.low[w];
+    }
+    else if ( (w != g_learn.parent[v]) && (g_learn.disc[w] < g_learn.low[v]) )
+      g_learn.low[v] = g_learn.disc[w];
+  }
+
+}  /* end of learn_cut_dfs() */
+
+
+/************************************************************/
+/* this function checks that the edges that aren't false leave the
+ * graph connected, without a cut vertex.  if not, the side S of the cut
+ * (and the rest R, without the cut vertex) is only joined to R by false
+ * edges, and one of them must be true:  else the cycle would have to go
+ * into and out of S through the cut vertex, which would need 4 edges.
+ * that clause is added, and is the conflict.
+ * returns LEARN_CONFLICT if a cut was found, LEARN_OK otherwise
+ */
+int
+learn_check_cuts()
+{
+  int numvert = g_learn.numvert;
+  int sfirst, slast;	/* disc[] range of S (disc 0 if disconnected) */
+  int cutvert = -1;
+  int child = -1;
+  int numchild = 0;
+  int loop, eloop;
+  int var, w;
+  int indisc;
+  int best;
+  int tmp;
+
+  for (loop = 0; loop < numvert; loop++)
+    g_learn.disc[loop] = 0;
+  g_learn.dfstime = 0;
+  g_learn.parent[0] = -1;
+  learn_cut_dfs(0);
+
+  if (g_learn.dfstime < numvert)
+  {
+    /* disconnected:  S is the vertices not reached */
+    sfirst = slast = 0;
+  }
+  else
+  {
+    for (loop = 1; loop < numvert; loop++)
+    {
+      if (g_learn.parent[loop] == 0)
+      {
+        numchild++;
+        if (child < 0)
+          child = loop;
+      }
+      else if (g_learn.low[loop] >= g_learn.disc[g_learn.parent[loop]])
+      {
+        child = loop;
+        cutvert = g_learn.parent[loop];
+        break;
+      }
+    }
+    if (cutvert < 0)
+    {
+      if (numchild < 2)
+        return(LEARN_OK);
+      cutvert = 0;
+    }
+    sfirst = g_learn.disc[child];
+    slast = sfirst + g_learn.size[child] - 1;
+  }
+
+  /* the false edges from S to R */
+  g_learn.numlits = 0;
+  for (loop = 0; loop < numvert; loop++)
+  {
+    indisc = g_learn.disc[loop];
+    if ( (indisc < sfirst) || (indisc > slast) )
+      continue;
+
+    for (eloop = 0; eloop < g_learn.graph->deg[loop]; eloop++)
+    {
+      w = g_learn.graph->nbr[loop][eloop];
+      indisc = g_learn.disc[w];
+      if ( (w == cutvert) || ( (indisc >= sfirst) && (indisc <= slast) ) )
+        continue;
+      var = g_learn.var[loop * MAXDEGREE + eloop];
+      g_learn.lits[g_learn.numlits++] = LIT_POS(var);
+    }
+  }
+
+  g_learn.numcuts++;
+
+  /* keep the clause, watching its 2 latest literals */
+  if (g_learn.numlits >= 2)
+  {
+    for (loop = 0; loop < 2; loop++)
+    {
+      best = loop;
+      for (eloop = loop + 1; eloop < g_learn.numlits; eloop++)
+      {
+        if (g_learn.level[LIT_VAR(g_learn.lits[eloop])] >
+	    g_learn.level[LIT_VAR(g_learn.lits[best])])
+          best = eloop;
+      }
+      tmp = g_learn.lits[loop];
+      g_learn.lits[loop] = g_learn.lits[best];
+      g_learn.lits[best] = tmp;
+    }
+    learn_add_clause(g_learn.lits, g_learn.numlits, 0);
+  }
+
+  return(learn_set_conflict(WHY_CUT, 0));
+
+}  /* end of learn_check_cuts() */
+
+
+/************************************************************/
+/* this function learns a clause from the conflict (with its literals
+ * in g_learn.lits, set at the current level), by resolving with the
+ * reasons of the current level's literals back to the first unique
+ * implication point.  the clause is left in g_learn.learnlits, with the
+ * literal that it asserts first, and the one of the highest other level
+ * second.
+ * returns the # of literals, and sets *btlevel to the level to jump
+ * back to
+ */
+int
+learn_analyze(
+  int *btlevel)
+{
+  int numlearn = 1;
+  int pathcount = 0;
+  int index = g_learn.trailnum - 1;
+  int lit = -1;
+  int var;
+  int loop;
+  int best;
+  int tmp;
+
+  while (1)
+  {
+    for (loop = 0; loop < g_learn.numlits; loop++)
+    {
+      var = LIT_VAR(g_learn.lits[loop]);
+      if ( (g_learn.seen[var]) || (g_learn.level[var] == 0) )
+        continue;
+
+      g_learn.seen[var] = 1;
+      learn_bump_var(var);
+      if (g_learn.level[var] >= g_learn.numlevel)
+        pathcount++;
+      else
+        g_learn.learnlits[numlearn++] = g_learn.lits[loop];
+    }
+
+    /* the latest literal of the current level in the clause */
+    while (!g_learn.seen[LIT_VAR(g_learn.trail[index])])
+      index--;
+    lit = g_learn.trail[index--];
+    var = LIT_VAR(lit);
+    g_learn.seen[var] = 0;
+    pathcount--;
+
+    if (pathcount == 0)
+      break;
+
+    learn_reason_lits(var);
+  }
+
+  g_learn.learnlits[0] = LIT_NOT(lit);
+  for (loop = 1; loop < numlearn; loop++)
+    g_learn.seen[LIT_VAR(g_learn.learnlits[loop])] = 0;
+
+  *btlevel = 0;
+  if (numlearn > 1)
+  {
+    best = 1;
+    for (loop = 2; loop < numlearn; loop++)
+    {
+      if (g_learn.level[LIT_VAR(g_learn.learnlits[loop])] >
+	  g_learn.level[LIT_VAR(g_learn.learnlits[best])])
+        best = loop;
+    }
+    tmp = g_learn.learnlits[1];
+    g_learn.learnlits[1] = g_learn.learnlits[best];
+    g_learn.learnlits[best] = tmp;
+    *btlevel = g_learn.level[LIT_VAR(g_learn.learnlits[1])];
+  }
+
+  return(numlearn);
+
+}  /* end of learn_analyze() */
+
+
+/************************************************************/
+/* returns the x'th term (from 0) of the luby sequence 1 1 2 1 1 2 4 ...
+ */
+int
+learn_luby(
+  int x)
+{
+  int size = 1;
+  int seq = 0;
+
+  while (size < x + 1)
+  {
+    seq++;
+    size = 2 * size + 1;
+  }
+
+  while (size - 1 != x)
+  {
+    size = (size - 1) / 2;
+    seq--;
+    x = x % size;
+  }
+
+  return(1 << seq);
+
+}  /* end of learn_luby() */
+
+
+/************************************************************/
+/* this function sets up the edge variables and the search state for
+ * the graph (from the trial's arena)
+ */
+void
+learn_init(
+  graph_type *graph)
+{
+  int numvert = graph->numvert;
+  int numvar = 0;
+  int loop, eloop, k;
+  int w;
+
+  memset(&g_learn, 0, sizeof(g_learn));
+  g_learn.graph = graph;
+  g_learn.numvert = numvert;
+
+  g_learn.var = ARENA_ARRAY(int, numvert * MAXDEGREE);
+  g_learn.end1 = ARENA_ARRAY(int, graph->numedges);
+  g_learn.end2 = ARENA_ARRAY(int, graph->numedges);
+
+  for (loop = 0; loop < numvert; loop++)
+  {
+    for (eloop = 0; eloop < graph->deg[loop]; eloop++)
+    {
+      w = graph->nbr[loop][eloop];
+      if (w < loop)
+        continue;
+
+      g_learn.end1[numvar] = loop;
+      g_learn.end2[numvar] = w;
+      g_learn.var[loop * MAXDEGREE + eloop] = numvar;
+      for (k = 0; graph->nbr[w][k] != loop; k++)
+        ;
+      g_learn.var[w * MAXDEGREE + k] = numvar;
+      numvar++;
+    }
+  }
+  g_learn.numvar = numvar;
+
+  g_learn.value = ARENA_ARRAY(char, numvar);
+  g_learn.phase = ARENA_ARRAY(char, numvar);
+  g_learn.why = ARENA_ARRAY(char, numvar);
+  g_learn.joined = ARENA_ARRAY(char, numvar);
+  g_learn.seen = ARENA_ARRAY(char, numvar);
+  g_learn.whydata = ARENA_ARRAY(int, numvar);
+  g_learn.level = ARENA_ARRAY(int, numvar);
+  g_learn.trailpos = ARENA_ARRAY(int, numvar);
+  g_learn.trail = ARENA_ARRAY(int, numvar);
+  g_learn.trail_lim = ARENA_ARRAY(int, numvar + 1);
+  g_learn.joinend1 = ARENA_ARRAY(int, numvar);
+  g_learn.joinend2 = ARENA_ARRAY(int, numvar);
+  g_learn.joinlen1 = ARENA_ARRAY(int, numvar);
+  g_learn.joinlen2 = ARENA_ARRAY(int, numvar);
+  g_learn.act = ARENA_ARRAY(double, numvar);
+  g_learn.heap = ARENA_ARRAY(int, numvar);
+  g_learn.heappos = ARENA_ARRAY(int, numvar);
+  g_learn.lits = ARENA_ARRAY(int, numvar + 1);
+  g_learn.learnlits = ARENA_ARRAY(int, numvar + 1);
+  g_learn.watch = ARENA_ARRAY(learn_vec_type, 2 * numvar);
+
+  g_learn.ntrue = ARENA_ARRAY(int, numvert);
+  g_learn.nfalse = ARENA_ARRAY(int, numvert);
+  g_learn.tvar = ARENA_ARRAY(int, 3 * numvert);
+  g_learn.pend = ARENA_ARRAY(int, numvert);
+  g_learn.plen = ARENA_ARRAY(int, numvert);
+  g_learn.disc = ARENA_ARRAY(int, numvert);
+  g_learn.low = ARENA_ARRAY(int, numvert);
+  g_learn.size = ARENA_ARRAY(int, numvert);
+  g_learn.parent = ARENA_ARRAY(int, numvert);
+
+  for (loop = 0; loop < numvert; loop++)
+  {
+    g_learn.ntrue[loop] = g_learn.nfalse[loop] = 0;
+    g_learn.pend[loop] = loop;
+    g_learn.plen[loop] = 1;
+  }
+
+  /* edges between low degree vertices are decided first, till the
+   * conflicts give them activities
+   */
+  for (loop = 0; loop < numvar; loop++)
+  {
+    g_learn.value[loop] = VAL_UNDEF;
+    g_learn.phase[loop] = VAL_TRUE;
+    g_learn.seen[loop] = 0;
+    g_learn.act[loop] = 1e-3 / (graph->deg[g_learn.end1[loop]] +
+		graph->deg[g_learn.end2[loop]]);
+    g_learn.heappos[loop] = -1;
+    learn_heap_insert(loop);
+  }
+  for (loop = 0; loop < 2 * numvar; loop++)
+  {
+    g_learn.watch[loop].data = NULL;
+    g_learn.watch[loop].num = g_learn.watch[loop].max = 0;
+  }
+
+  g_learn.varinc = 1.0;
+  g_learn.clainc = 1.0;
+  g_learn.maxlearn = g_options.learn_alg.maxlearn;
+
+}  /* end of learn_init() */
+
+
+/************************************************************/
+/* this function frees the clauses and watch lists (the rest is in the
+ * trial's arena)
+ */
+void
+learn_free()
+{
+  int loop;
+
+  for (loop = 0; loop < g_learn.numclause; loop++)
+    free(g_learn.clause[loop].lits);
+  free(g_learn.clause);
+  g_learn.clause = NULL;
+
+  for (loop = 0; loop < 2 * g_learn.numvar; loop++)
+    free(g_learn.watch[loop].data);
+
+}  /* end of learn_free() */
+
+
+/************************************************************/
+/* this function runs the learning search on the (pruned) graph.
+ * returns HC_FOUND if the true edges are a hamiltonian cycle,
+ * HC_NOT_EXIST if the search proved there is none, or HC_NOT_FOUND if
+ * it was stopped by the time limit
+ */
+int
+learn_search()
+{
+  int ret;
+  int loop;
+  int var;
+  int numlearn;
+  int btlevel;
+  int maxlevel;
+  int nextrestart;
+  int sincerestart = 0;
+  int sincecheck = 0;
+
+  nextrestart = g_options.learn_alg.restart * learn_luby(0);
+
+  /* the degree constraints of vertices with only 2 edges */
+  ret = LEARN_OK;
+  for (loop = 0; (loop < g_learn.numvert) && (ret == LEARN_OK); loop++)
+    ret = learn_prop_vertex(loop);
+
+  while (1)
+  {
+    if ( (ret == LEARN_OK) && (!g_learn.found) )
+      ret = learn_propagate();
+    if ( (ret == LEARN_OK) && (!g_learn.found) )
+      ret = learn_check_cuts();
+
+    if (g_learn.found)
+      return(HC_FOUND);
+
+    if (ret == LEARN_CONFLICT)
+    {
+      g_learn.conflicts++;
+      sincerestart++;
+      sincecheck++;
+      learn_conflict_lits();
+
+      /* a conflict with only level 0 literals means no cycle.  (a cut
+       * clause can be broken at a level below the current one:  jump
+       * back to that level before analysing it)
+       */
+      maxlevel = 0;
+      for (loop = 0; loop < g_learn.numlits; loop++)
+      {
+        if (g_learn.level[LIT_VAR(g_learn.lits[loop])] > maxlevel)
+          maxlevel = g_learn.level[LIT_VAR(g_learn.lits[loop])];
+      }
+      if (maxlevel == 0)
+        return(HC_NOT_EXIST);
+      learn_backtrack(maxlevel);
+
+      numlearn = learn_analyze(&btlevel);
+      learn_backtrack(btlevel);
+
+      if (numlearn == 1)
+        ret = learn_assign(g_learn.learnlits[0], WHY_DECISION, 0);
+      else
+        ret = learn_assign(g_learn.learnlits[0], WHY_CLAUSE,
+		learn_add_clause(g_learn.learnlits, numlearn, 1));
+
+      g_learn.varinc /= g_options.learn_alg.decay;
+      g_learn.clainc /= 0.999;
+      continue;
+    }
+
+    /* time limit */
+    if (++sincecheck >= LEARN_TIMECHECK)
+    {
+      sincecheck = 0;
+      PROGRESS_STORE(nodes, g_learn.decisions);
+      PROGRESS_STORE(pathlen, g_learn.trailnum);
+      if (g_learn.trailnum > PROGRESS_LOAD(maxpath))
+        PROGRESS_STORE(maxpath, g_learn.trailnum);
+      PROGRESS_STORE(restart, g_learn.restarts);
+      if (hc_check_timelimit() == HC_QUIT)
+        return(HC_NOT_FOUND);
+    }
+
+    if ( (g_options.learn_alg.restart > 0) && (sincerestart >= nextrestart) )
+    {
+      g_learn.restarts++;
+      sincerestart = 0;
+      nextrestart = g_options.learn_alg.restart *
+		learn_luby(g_learn.restarts);
+      learn_backtrack(0);
+    }
+
+    if (g_learn.numlearnt - g_learn.trailnum >= g_learn.maxlearn)
+      learn_reduce();
+
+    /* decide the most active edge that has no value yet */
+    var = -1;
+    while (g_learn.heapnum > 0)
+    {
+      var = learn_heap_pop();
+      if (g_learn.value[var] == VAL_UNDEF)
+        break;
+      var = -1;
+    }
+    if (var < 0)
+    {
+      /* every edge is set, without the cycle being closed (can't
+       * happen:  the degrees are 2 and the graph is connected)
+       */
+      return(HC_NOT_FOUND);
+    }
+
+    g_learn.decisions++;
+    g_learn.trail_lim[g_learn.numlevel++] = g_learn.trailnum;
+    ret = learn_assign( (g_learn.phase[var] == VAL_TRUE) ? LIT_POS(var) :
+		LIT_NEG(var), WHY_DECISION, 0);
+  }
+
+}  /* end of learn_search() */
+
+
+/************************************************************/
+/* Hamiltonian Cycle Learning Search Wrapper Function
+ *   does the initial pruning, then runs the learning search on the
+ *   pruned graph
+ *   returns HC_FOUND (with the cycle in solution), HC_NOT_EXIST if
+ *   there is no hamiltonian cycle, or HC_NOT_FOUND if the time limit
+ *   was reached
+ */
+int
+master_learn_alg(
+  graph_type *graph,
+  stat_pertrial_type *trialstats,
+  int solution[])
+{
+  int ret;
+  int prune = 0;
+  graph_type *testgraph = ARENA_NEW(graph_type);
+  int loop;
+  int prev, cur, next;
+  int var;
+
+  /* update statistics */
+  trialstats->edgeprune = 0;
+  trialstats->nodes = 0;
+  trialstats->retries = 0;
+
+  /* copy passed in graph to second graph data structure
+   * so that original graph isn't overwritten when pruning, etc.
+   */
+  PHASE_START(PHASE_COPY);
+  copy_graph(graph, testgraph);
+  PHASE_STOP(PHASE_COPY);
+
+  /* do initial H.C. pruning, and run tests to see if H.C. can exist */
+  PHASE_START(PHASE_INITPRUNE);
+  ret = hc_do_pruning(testgraph, &prune, HC_PRUNE_ALL, NULL);
+  PHASE_STOP(PHASE_INITPRUNE);
+  trialstats->edgeprune = prune;
+
+  if (ret == HC_NOT_EXIST)
+  {
+    return(HC_NOT_EXIST);
+  }
+
+  learn_init(testgraph);
+
+  PHASE_START(PHASE_SEARCH);
+  ret = learn_search();
+  PHASE_STOP(PHASE_SEARCH);
+
+  trialstats->nodes = g_learn.decisions;
+  trialstats->retries = g_learn.restarts;
+
+  if (g_options.report_flags & REPORT_ALG)
+  {
+    fprintf(g_options.log_fp, "Learning search made %d decisions, "
+	"%d conflicts, %d restarts, learned %d clauses (%d kept), "
+	"%d cut clauses.\n", g_learn.decisions, g_learn.conflicts,
+	g_learn.restarts, g_learn.totlearnt, g_learn.numlearnt,
+	g_learn.numcuts);
+  }
+
+  if (ret == HC_FOUND)
+  {
+    /* follow the true edges around from vertex 0 */
+    prev = -1;
+    cur = 0;
+    for (loop = 0; loop < testgraph->numvert; loop++)
+    {
+      solution[loop] = cur;
+      var = g_learn.tvar[3 * cur];
+      next = (g_learn.end1[var] == cur) ? g_learn.end2[var] :
+		g_learn.end1[var];
+      if (next == prev)
+      {
+        var = g_learn.tvar[3 * cur + 1];
+        next = (g_learn.end1[var] == cur) ? g_learn.end2[var] :
+		g_learn.end1[var];
+      }
+      prev = cur;
+      cur = next;
+    }
+  }
+
+  learn_free();
+
+  return(ret);
+
+}  /* end of master_learn_alg() */
+
+
+/************************************************************/
+/* learning search option routines, for handling the options
+ * associated with the learning search
+ */
+/************************************************************/
+
+/************************************************************/
+/* this function parses the option file for parameters for using
+ * the learning search.
+ *
+ * input parameters:  word : the argument
+ *                      fp : file pointer to file, set to the parameters of
+ *                           the argument
+ * output parameters: word : the next argument/comment (non-parameter) word
+ *                  return : the status of the most recent read
+ *
+ * option file parameters are:
+ *
+ *  +restart=<n>   : restart after n * (luby sequence) conflicts (0 = never)
+ *  +maxlearn=<n>  : learned clauses kept before dropping the less active
+ *  +decay=<f>     : multiply edge activities by f after each conflict
+ *
+ */
+int
+parse_learn_alg_options(
+  FILE *fp,
+  char word[])
+{
+  int status;
+
+  char parmstr[STRLEN];
+  char valstr[STRLEN];
+
+  /* read next word in options file */
+  status = read_next_word(fp, word);
+
+  /* read next parameter, till read a non-parameter word, then return */
+  while ( !(status & READ_EOF) )
+  {
+    if (check_word(word) == WORD_PARM)
+    {
+      /* parse the parameter */
+      parse_parameter_str(word, parmstr, valstr);
+
+      /* restart parameter */
+      if (strcasecmp(parmstr, "+restart")==0)
+      {
+        g_options.learn_alg.restart = atoi(valstr);
+        if (g_options.learn_alg.restart < 0)
+        {
+          EXIT_ERROR1("Invalid value `%s' for +restart parameter.\n",valstr);
+        }
+      }
+
+      /* maxlearn parameter */
+      else if (strcasecmp(parmstr, "+maxlearn")==0)
+      {
+        g_options.learn_alg.maxlearn = atoi(valstr);
+        if (g_options.learn_alg.maxlearn <= 0)
+        {
+          EXIT_ERROR1("Invalid value `%s' for +maxlearn parameter.\n",valstr);
+        }
+      }
+
+      /* decay parameter */
+      else if (strcasecmp(parmstr, "+decay")==0)
+      {
+        g_options.learn_alg.decay = atof(valstr);
+        if ( (g_options.learn_alg.decay <= 0.0) ||
+             (g_options.learn_alg.decay >= 1.0) )
+        {
+          EXIT_ERROR1("Invalid value `%s' for +decay parameter.\n",valstr);
+        }
+      }
+
+      else
+      {
+        WARN_ERROR1("Warning: Unidentified parameter `%s'.\n", parmstr);
+      }
+    }
+    else
+    {
+      return (status);
+    }
+
+    status = read_next_word(fp, word);
+
+  }  /* end of while loop */
+
+  return(status);
+
+}  /* end of parse_learn_alg_options() */
+
+
+/************************************************************/
+/* this function initializes the learning search options
+ */
+void
+init_learn_alg_options()
+{
+  g_options.learn_alg.restart = LEARN_DEF_RESTART;
+  g_options.learn_alg.maxlearn = LEARN_DEF_MAXLEARN;
+  g_options.learn_alg.decay = LEARN_DEF_DECAY;
+
+}  /* end of init_learn_alg_options() */
+
+
+/************************************************************/
+/* this function prints the learning search options
+ */
+void
+print_learn_alg_options(
+  FILE *fp)
+{
+  fprintf(fp, "    restart unit (conflicts) = %d\n",
+	g_options.learn_alg.restart);
+  fprintf(fp, "    learned clauses kept = %d\n", g_options.learn_alg.maxlearn);
+  fprintf(fp, "    activity decay = %.3f\n", g_options.learn_alg.decay);
+
+}  /* end of print_learn_alg_options() */
+
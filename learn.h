@@ -0,0 +1,44 @@
+
+
+#ifndef _LEARN_H_
+#define _LEARN_H_
+
+
+/************************************************************/
+/* defines and data structures */
+/************************************************************/
+
+/* default values for the learning search parameters */
+#define LEARN_DEF_RESTART	100	/* conflicts per luby restart unit */
+#define LEARN_DEF_MAXLEARN	5000	/* learned clauses kept before the
+					 * less active half is dropped */
+#define LEARN_DEF_DECAY		0.95	/* edge activity decay */
+
+/* how often (in decisions and conflicts) to check the time limit */
+#define LEARN_TIMECHECK		256
+
+/* options structure */
+typedef struct {
+
+  int restart;		/* luby restart unit in conflicts, 0 = no restarts */
+  int maxlearn;		/* learned clauses kept (grows 10% per reduction) */
+  float decay;		/* edge activity decay factor */
+
+}  learn_alg_options_type;
+
+
+/************************************************************/
+/* function declarations */
+/************************************************************/
+
+int master_learn_alg( graph_type *graph, stat_pertrial_type *trialstats,
+	int solution[]);
+
+int parse_learn_alg_options( FILE *fp, char word[]);
+
+void init_learn_alg_options();
+
+void print_learn_alg_options( FILE *fp);
+
+#endif /* _LEARN_H_ */
+
@@ -46,216 +46,6 @@ test_graph_properties(
 }  /* end of test_graph_properties() */
 
 
-/************************************************************/
-/* function to generate desired graph, using options
- * note that graph statistics are also calculated
- */
-void
-generate_graph(
-  graph_type *graph)
-{
-  int done = 0;
-  int flags;
-  int alg;
-  long algtime;
-  stat_pertrial_type trialstat;
-  int solution[MAXVERT];
-  int ret;
-  int num_edges;
-
-  do   /* do-while loop for hamiltonicity */
-  {
-    switch(g_options.graphgentype)
-    {
-      case GEN_ICCS:
-        gen_iccs_graph( graph, g_options.graphgen.numsubgraphs,
-		g_options.graphgen.indsetsize);
-	break;
-
-      case GEN_ADDPATH:
-        gen_addpath_graph( graph, g_options.graphgen.nvertex,
-		2, g_options.graphgen.pathlengths);
-	break;
-
-      case GEN_ADDCYCLE:	
-        gen_addcycle_graph( graph, g_options.graphgen.nvertex,
-				g_options.graphgen.numcycles);
-	break;
-
-      case GEN_RANDOM:	
-	/* if degconst is specified, then calculate the mean degree */
-        if (g_options.graphgen.degconst > 0.0)
-        {
-          g_options.graphgen.meandeg = g_options.graphgen.degconst *
-		(float) (log( (double) g_options.graphgen.nvertex) +
-		 log(log( (double) g_options.graphgen.nvertex)));
-        }
-      
-        /* calculate the number of edges */
-        num_edges = (int) ( ( (float) g_options.graphgen.meandeg * 
-		g_options.graphgen.nvertex) / 2.0 );
-        gen_random_graph( graph, g_options.graphgen.nvertex, num_edges);
-        break;
-
-      case GEN_CROSSROADS:	
-        gen_crossroads_graph( graph, g_options.graphgen.numsubgraphs);
-        break;
-
-      case GEN_DEGREEBOUND:	
-        gen_degbound_graph( graph, g_options.graphgen.nvertex,
-  			g_options.graphgen.degsize,
-  			g_options.graphgen.degpercent);
-        break;
-  
-      case GEN_KNIGHTTOUR:	
-  
-        gen_knighttour_graph( graph, g_options.graphgen.board1,
-  			g_options.graphgen.board2,
-  			g_options.graphgen.move1,
-  			g_options.graphgen.move2);
-  
-        break;
-  
-      case GEN_GEOMETRIC:
-  
-        gen_geo_graph( 	g_options.graphgen.nvertex,
-  			g_options.graphgen.dist * g_options.graphgen.dist,
-  			g_options.graphgen.dflag, 
-  			g_options.graphgen.dim, 
-  			g_options.graphgen.wrapflag, graph);
-        break;
-  
-      default:
-        EXIT_ERROR("Error: invalid graph type in generate_graph().\n");
-        break;
-  
-    }  /* end of switch statement */
-
-    if (g_options.graphgen.makeham != HAM_ENSURE)
-    {
-      done = 1;
-    }
-    else /* need to confirm that cycle exists; use backtrack algorithm */
-    {
-      flags = g_options.report_flags;
-      alg = g_options.algorithm;
-      algtime = g_options.alg_timelimit;
-      g_options.report_flags = REPORT_NONE;
-      g_options.algorithm = ALG_BACKTRACK;
-      g_options.alg_timelimit = -1;	
-
-      trialstat.result = HC_NOT_FOUND;
-
-      /* set algorithm options */
-      g_options.bt_alg.initvertflag = INITVERT_RANDOM;
-      g_options.bt_alg.degsortflag = DEGSORT_MIN;
-      g_options.bt_alg.pruneoptflag = HC_PRUNE_BASIC | HC_PRUNE_CYC;
-
-      ret = master_backtrack_alg(graph, &trialstat, solution);
-      
-      if (ret == HC_FOUND)
-        done = 1;
-      else
-      {
-        if (flags & REPORT_ALG)
-        {
-        fprintf(g_options.log_fp,"  Regenerating graph (not hamiltonian)...\n");
-        }
-      }
-
-      /* restore flags */
-      g_options.report_flags = flags;
-      g_options.algorithm = alg;
-      g_options.alg_timelimit = algtime;
-
-    }  /* end of makeham code */
-
-  } while(!done);  /* hamiltonicity while loop */
-
-  /* graph is generated, so calculate graph statistics */
-  calc_graph_stats(graph);
-
-}  /* end of generate_graph() */
-
-
-/************************************************************/
-/* this function prints out the information for the summary file
- * if printflag == PRINT_INFO_HEADER then just the header is printed
- * otherwise everything is printed
- */
-void
-print_info_summary(
-  stat_exp_type *stats,
-  FILE *fp,
-  int printflag)
-{
-  char sumstr[STRLEN];
- 
-  print_experiment_summary(sumstr);
-
-  /* note that if multiple graphs tested, additional information
-   * is printed out (after normal information)
-   */
- 
-  /* print out header */
-  fprintf(fp, "%30s", "Experiment");
-
-  if (g_options.algorithm == ALG_POSA_HEUR)
-  {
-    /* print heuristic stats */
-    fprintf(fp, "\t%% ham graph");
-    fprintf(fp, "\talg success");
-    fprintf(fp, "\texpected time");
-  }
-  else
-  if ( (g_options.algorithm == ALG_NOPRUNE_BT) ||
-        (g_options.algorithm == ALG_BACKTRACK) )
-  {
-    /* print backtrack stats */
-    fprintf(fp, "\t%% ham graph");
-    fprintf(fp, "\talg success");
-    fprintf(fp, "\texpected time");
-  }
-  else
-  {
-    /* print combination */
-    fprintf(fp, "\t%% ham graph");
-    fprintf(fp, "\talg success");
-    fprintf(fp, "\texpected time");
-  }
-
-  fprintf(fp, "\n");
-
-  if (printflag == PRINT_INFO_HEADER)
-    return;
-
-  /* print out information */
-  fprintf(fp, "%30s", sumstr);
-
-  if (g_options.algorithm == ALG_POSA_HEUR)
-  {
-    /* print heuristic stats */
-    fprintf(fp, "\t%.1f %%    ", stats->perham.ave*100);
-    fprintf(fp, "\t%.1f %%    ", stats->algsuccess.ave*100);
-    fprintf(fp, "\t%.1f (%.1f)", stats->tmexpect.ave,
-	stats->tmexpect.stddev);
-  }
-  else
-  if ( (g_options.algorithm == ALG_NOPRUNE_BT) ||
-        (g_options.algorithm == ALG_BACKTRACK) )
-  {
-    /* print backtrack stats */
-    fprintf(fp, "\t%.1f %%    ", stats->perham.ave*100);
-    fprintf(fp, "\t%.1f %%    ", stats->algsuccess.ave*100);
-    fprintf(fp, "\t%.1f (%.1f)", stats->tmexpect.ave,
-	stats->tmexpect.stddev);
-  }
-
-  fprintf(fp, "\n");
-
-}  /* end of print_info_summary() */
-
-
 /************************************************************/
 /* function to perform the experiments
  *   - load/generate graph
@@ -269,7 +59,7 @@ void
 perform_experiments() 
 {
   graph_type graph;
-  stat_exp_type stats;
+  static stat_exp_type stats;	/* too big for the stack */
 
   int trialnum = 0;
   int graphnum = 0;
@@ -278,6 +68,7 @@ perform_experiments()
 
   int gloop, iloop;
   int ret = 0;
+  int ensured = ENSURED_NONE;	/* how the current graph was made hamiltonian */
  
   /************************************************************/
   /* obtain graph for testing */
@@ -301,7 +92,8 @@ perform_experiments()
   }
   else
   {
-    generate_graph(&graph);
+    pipeline_start();
+    ensured = pipeline_next_graph(&graph, 0);
   }
  
   /************************************************************/
@@ -325,6 +117,9 @@ perform_experiments()
   /* set up statistics */
   init_exp_stats(&stats);
 
+  if (g_options.progress_interval > 0)
+    progress_start();
+
   /************************************************************/
   /* start looping through experiments */
   while(1)
@@ -368,6 +163,10 @@ perform_experiments()
       case ALG_NOPRUNE_BT:
       case ALG_BACKTRACK:
       case ALG_POSA_HEUR:
+      case ALG_ANNEAL:
+      case ALG_DECOMP:
+      case ALG_LEARN:
+        progress_trial(graphnum+1, trialnum+1);
         ret = test_hc_alg(&graph, &(stats.graph[graphnum].trial[trialnum]) );
         break;
 
@@ -424,6 +223,7 @@ perform_experiments()
        * this assumes graph data structure was never changed
        */
       test_graph_properties(&graph, &(stats.graph[graphnum]));
+      stats.graph[graphnum].ensured = ensured;
 
       graphnum++;
       trialnum = 0;
@@ -434,8 +234,8 @@ perform_experiments()
         if (g_options.report_flags & REPORT_ALG)
           fprintf(g_options.log_fp, "\n");
  
-        init_graph(&graph);		/* this resets solve flag */
-        generate_graph(&graph);
+        /* this resets solve flag */
+        ensured = pipeline_next_graph(&graph, graphnum);
 
       }
     }
@@ -444,7 +244,12 @@ perform_experiments()
 
   /* print out all the statistics - first print header */
   fprintf(g_options.stats_fp, 
-	"\nGraph\tTrial\tSolve?\tTime\tNodes\tNodes/NumVert\n");
+	"\nGraph\tTrial\tSolve?\tTime\tNodes\tNodes/NumVert");
+  if (g_options.report_flags & REPORT_HWCOUNTERS)
+    fprintf(g_options.stats_fp, "\tIPC\tL1miss/N\tLLCmiss/N\tBrmiss/N");
+  if (g_options.bt_alg.countflag == COUNT_ON)
+    fprintf(g_options.stats_fp, "\tCycles\tCycles/sec");
+  fprintf(g_options.stats_fp, "\n");
 
   /* loop through graphs and trials, printing information */
   for (gloop = 0; gloop < g_options.num_graph_tests; gloop++)
@@ -458,11 +263,18 @@ perform_experiments()
         fprintf(g_options.stats_fp, "si\t");
       else
         fprintf(g_options.stats_fp, "no\t");
-      fprintf(g_options.stats_fp, "%.1f\t%d\t%.1f\n",
+      fprintf(g_options.stats_fp, "%.1f\t%d\t%.1f",
 		stats.graph[gloop].trial[iloop].time,
 		stats.graph[gloop].trial[iloop].nodes,
 	        (float) ((float) stats.graph[gloop].trial[iloop].nodes /
 	                 (float) g_options.graphgen.nvertex) );
+      if (g_options.report_flags & REPORT_HWCOUNTERS)
+        print_trial_hw_stats(g_options.stats_fp, 
+		&(stats.graph[gloop].trial[iloop]) );
+      if (g_options.bt_alg.countflag == COUNT_ON)
+        print_trial_count_stats(g_options.stats_fp, 
+		&(stats.graph[gloop].trial[iloop]) );
+      fprintf(g_options.stats_fp, "\n");
     }
 
     /* print GRAPH_INST statistics */
@@ -474,6 +286,19 @@ perform_experiments()
     else
       fprintf(g_options.stats_fp, "unknown\n");
 
+    if (stats.graph[gloop].ensured != ENSURED_NONE)
+    {
+      fprintf(g_options.stats_fp, "\tHamiltonicity ensured by: ");
+      if (stats.graph[gloop].ensured == ENSURED_BACKTRACK)
+        fprintf(g_options.stats_fp, "backtrack\n");
+      else if (stats.graph[gloop].ensured == ENSURED_POSA)
+        fprintf(g_options.stats_fp, "posa\n");
+      else if (stats.graph[gloop].ensured == ENSURED_BOUNDED)
+        fprintf(g_options.stats_fp, "bounded backtrack\n");
+      else
+        fprintf(g_options.stats_fp, "planted cycle\n");
+    }
+
   }
 
   /* calculate overall statistics */
@@ -482,7 +307,8 @@ perform_experiments()
   /* print overall stats */
   fprintf(g_options.stats_fp, "\n\nOverall Statistics\n\n");
 
-  if (g_options.algorithm == ALG_POSA_HEUR)
+  if ( (g_options.algorithm == ALG_POSA_HEUR) ||
+        (g_options.algorithm == ALG_ANNEAL) )
   {
     /* print heuristic stats */
     fprintf(g_options.stats_fp, 
@@ -499,7 +325,9 @@ perform_experiments()
   }
   else
   if ( (g_options.algorithm == ALG_NOPRUNE_BT) || 
-	(g_options.algorithm == ALG_BACKTRACK) )
+	(g_options.algorithm == ALG_BACKTRACK) ||
+	(g_options.algorithm == ALG_DECOMP) ||
+	(g_options.algorithm == ALG_LEARN) )
   {
     /* print backtrack stats */
     fprintf(g_options.stats_fp, 
@@ -569,12 +397,53 @@ perform_experiments()
         stats.noderatio_nofound.ave, stats.noderatio_nofound.stddev);
   fprintf(g_options.stats_fp, "\n");
 
+#if PHASE_TIMING
+  fprintf(g_options.stats_fp, "EE:Phase:");
+  for (iloop = 0; iloop < NUM_PHASES; iloop++)
+  {
+    fprintf(g_options.stats_fp, "%s%s", (iloop == 0) ? "" : ",", 
+	phase_str[iloop]);
+  }
+  fprintf(g_options.stats_fp, ":");
+  for (iloop = 0; iloop < NUM_PHASES; iloop++)
+  {
+    fprintf(g_options.stats_fp, "  %.4f (%.4f)", 
+	stats.phasetime[iloop].ave, stats.phasetime[iloop].stddev);
+  }
+  fprintf(g_options.stats_fp, "\n");
+#endif
+
+  if ( (g_options.report_flags & REPORT_HWCOUNTERS) && 
+       (stats.hwtrials[HW_INSTR] > 0) )
+  {
+    fprintf(g_options.stats_fp, 
+      "FF:HW:IPC,L1miss/Node,LLCmiss/Node,Brmiss/Node:");
+    for (iloop = HW_INSTR; iloop < NUM_HWCOUNTERS; iloop++)
+    {
+      if (stats.hwtrials[iloop] == 0)
+        fprintf(g_options.stats_fp, "  -");
+      else if (iloop == HW_INSTR)
+        fprintf(g_options.stats_fp, " %.2f (%.2f)", 
+		stats.hwstat[iloop].ave, stats.hwstat[iloop].stddev);
+      else
+        fprintf(g_options.stats_fp, "  %.1f (%.1f)", 
+		stats.hwstat[iloop].ave, stats.hwstat[iloop].stddev);
+    }
+    fprintf(g_options.stats_fp, "\n");
+  }
+
   fprintf(g_options.stats_fp, "\n");
 
   /* write to summary file if it is being used */
   if (g_options.report_flags & REPORT_SUMMARY)
     print_info_summary(&stats, g_options.summary_fp, PRINT_INFO_ALL);
 
+  hw_counters_close();
+  pipeline_stop();
+  arena_free();
+
+  progress_stop();
+
 }  /* end of perform_experiments() */
 
 
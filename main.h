@@ -8,6 +8,7 @@
 #include <string.h>
 #include <ctype.h>
 #include <sys/time.h>
+#include <time.h>
 #include <sys/resource.h>
 #include <math.h>
 #include <strings.h>
@@ -45,13 +46,21 @@
 
 #include "graphdata.h"		/* needs to be at the top */
 #include "stats.h"		/* needs to be near the top */
+#include "hwcount.h"
+#include "progress.h"
+#include "arena.h"
+#include "pipeline.h"
 
 #include "graphgen.h"
 
 #include "hamcycle.h"
 
 #include "backtrack.h"
+#include "count.h"
 #include "heuristic.h"
+#include "anneal.h"
+#include "decomp.h"
+#include "learn.h"
 
 #include "tester.h"		/* needs to be near the top */
 #include "options.h"	/* must be below other module includes */
@@ -79,16 +88,6 @@ int system();
 extern long random(); */
 extern  int getrusage(int who, struct rusage *rusage);
 
-/* defines for print_info_summary() function */
-#define PRINT_INFO_HEADER 	0
-#define PRINT_INFO_ALL 		1
-
-/************************************************************/
-/* function declarations */
-/************************************************************/
-
-void print_info_summary( stat_exp_type *stats, FILE *fp, int printflag);
-
 
 #endif /* _MAIN_H_ */
 
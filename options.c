@@ -325,6 +325,7 @@ parse_argument(
     {
       case ALG_NOPRUNE_BT:
       case ALG_BACKTRACK:
+      case ALG_DECOMP:
         status = parse_backtrack_alg_options(fp, word);
         readextra = 1;  
         break;
@@ -333,6 +334,16 @@ parse_argument(
         status = parse_heuristic_alg_options(fp, word);
         readextra = 1;  
         break;
+
+      case ALG_ANNEAL:
+        status = parse_anneal_alg_options(fp, word);
+        readextra = 1;  
+        break;
+
+      case ALG_LEARN:
+        status = parse_learn_alg_options(fp, word);
+        readextra = 1;  
+        break;
     }
       
   }  /* end of -algorithm */ 
@@ -440,6 +451,8 @@ parse_argument(
      *   +SOLUTION	: print solution to problem if found (default on)
      *   +OPTIONS	: print option settings 
      *   +SUMMARY	: print one-line summary
+     *   +HWCOUNTERS	: hardware performance counters per trial
+     *   +TREE		: search tree profile per trial (with +ALG)
      *
      * default = none
      */
@@ -461,6 +474,10 @@ parse_argument(
           g_options.report_flags |= REPORT_OPTIONS;
         else if (strcasecmp(word, "+summary") == 0)
           g_options.report_flags |= REPORT_SUMMARY;
+        else if (strcasecmp(word, "+hwcounters") == 0)
+          g_options.report_flags |= REPORT_HWCOUNTERS;
+        else if (strcasecmp(word, "+tree") == 0)
+          g_options.report_flags |= REPORT_TREE;
         else
         {
           WARN_ERROR1("Warning:  Unidentified parameter `%s'.\n", word);
@@ -504,6 +521,63 @@ parse_argument(
   }  /* end of -timelimit */ 
   else
 
+  /* progress sampling argument:
+   * format: 
+   *   -progress <sec>
+   */
+  if ( (strcasecmp(word, "-progress")==0) )
+  {
+    status = read_next_word(fp, word);
+ 
+    if (status & READ_EOF)
+    {
+      EXIT_ERROR("Unexpected end of file when processing -progress option.\n");
+    }
+
+    if (check_word(word) != WORD_OTHER)
+    {
+      EXIT_ERROR("Interval not specified for -progress option.\n");
+    }
+
+    g_options.progress_interval = (int) atoi(word);
+
+    if (g_options.progress_interval < 0) 
+    {
+      EXIT_ERROR1("Invalid interval %s specified for -progress option.\n", word);
+    }
+
+  }  /* end of -progress */ 
+  else
+
+  /* graph generation pipeline argument:
+   * format: 
+   *   -pipeline <numgen>
+   */
+  if ( (strcasecmp(word, "-pipeline")==0) )
+  {
+    status = read_next_word(fp, word);
+ 
+    if (status & READ_EOF)
+    {
+      EXIT_ERROR("Unexpected end of file when processing -pipeline option.\n");
+    }
+
+    if (check_word(word) != WORD_OTHER)
+    {
+      EXIT_ERROR("# of generators not specified for -pipeline option.\n");
+    }
+
+    g_options.pipeline_gens = (int) atoi(word);
+
+    if ( (g_options.pipeline_gens < 0) || 
+	 (g_options.pipeline_gens > MAXPIPEGENS) )
+    {
+      EXIT_ERROR1("Invalid # of generators %s specified for -pipeline option.\n", word);
+    }
+
+  }  /* end of -pipeline */ 
+  else
+
   /* random number seed argument:
    * format: 
    *   -randseed <seed>
@@ -660,9 +734,55 @@ verify_option_consistancy()
     WARN_ERROR("graph generated will be presented.\n");
   }
 
+  /* the search tree profile is written to the log file */
+  if ( (g_options.report_flags & REPORT_TREE) &&
+       !(g_options.report_flags & REPORT_ALG) )
+  {
+    WARN_ERROR("Warning: the `report search tree' option needs -report +alg");
+    WARN_ERROR(" (the profile is written to the log file).\n");
+  }
+
+  /* the pipeline only helps when generating several graphs to solve */
+  if ( (g_options.pipeline_gens > 0) && 
+       ( (g_options.graphgentype == GEN_NOGRAPH) ||
+	 (g_options.num_graph_tests < 2) ||
+	 (g_options.algorithm == ALG_NOSOLVE) ) )
+  {
+    WARN_ERROR("Warning: the graph pipeline needs several generated graphs");
+    WARN_ERROR(" to solve.\n  Ignoring -pipeline option.\n");
+    g_options.pipeline_gens = 0;
+  }
+
+  /* cycle counting is done by the pruning backtrack, in one search */
+  if (g_options.bt_alg.countflag == COUNT_ON)
+  {
+    if (g_options.algorithm != ALG_BACKTRACK)
+    {
+      WARN_ERROR("Warning: `+count' is only for -algorithm backtrack.");
+      WARN_ERROR("  Ignoring it.\n");
+      g_options.bt_alg.countflag = COUNT_OFF;
+    }
+    else if (g_options.bt_alg.restart_increment > 0)
+    {
+      WARN_ERROR("Warning: `+restart' can not be used when counting cycles.");
+      WARN_ERROR("  Ignoring it.\n");
+      g_options.bt_alg.restart_increment = 0;
+    }
+
+    /* the cycles are listed in the solution file by one process */
+    if ( (g_options.report_flags & REPORT_SOLUTION) &&
+	 (g_options.bt_alg.count_workers > 1) )
+    {
+      WARN_ERROR("Warning: listing the counted cycles (-report +solution)");
+      WARN_ERROR(" needs 1 count worker.\n  Ignoring `+countworkers'.\n");
+      g_options.bt_alg.count_workers = 1;
+    }
+  }
+
   /* if using ensureham option, should only be using heuristic algorithms */
-  if ( (g_options.graphgen.makeham == HAM_ENSURE) 
-	&& (g_options.algorithm != ALG_POSA_HEUR) )
+  if ( (g_options.graphgen.makeham != HAM_DONTCARE) 
+	&& (g_options.algorithm != ALG_POSA_HEUR)
+	&& (g_options.algorithm != ALG_ANNEAL) )
   {
     EXIT_ERROR("Can only using `+ensureham' option with heuristic algorithms.\n");
   }
@@ -671,27 +791,17 @@ verify_option_consistancy()
 
 
 /************************************************************/
-/* this function loads and parses the option file
- * 
+/* this function parses options (in the option file format) from an
+ * open stream, and verifies them
  */
 void
-parse_option_file(
-  char filename[])
+parse_option_stream(
+  FILE *fp)
 {
-  FILE *fp;
   char word[STRLEN];
   int status;
   int wordtype;
 
-
-  /* open file for reading */
-  fp = fopen (filename, "r");
-  if (fp == NULL)
-  {
-    EXIT_ERROR1("Error opening options file `%s'.\n",filename);
-  }
-
-  
   /* read first word */
   status = read_next_word(fp, word);
 
@@ -741,6 +851,28 @@ parse_option_file(
   /* verify that argument settings are consistant */
   verify_option_consistancy();
 
+}  /* end of parse_option_stream() */
+
+
+/************************************************************/
+/* this function loads and parses the option file
+ * 
+ */
+void
+parse_option_file(
+  char filename[])
+{
+  FILE *fp;
+
+  /* open file for reading */
+  fp = fopen (filename, "r");
+  if (fp == NULL)
+  {
+    EXIT_ERROR1("Error opening options file `%s'.\n",filename);
+  }
+
+  parse_option_stream(fp);
+
   /* close option file */
   fclose(fp);
 
@@ -760,6 +892,8 @@ init_options()
   g_options.algorithm = ALG_NOSOLVE;
 
   g_options.alg_timelimit = -1;		/* no timelimit */
+  g_options.progress_interval = 0;	/* no progress samples */
+  g_options.pipeline_gens = 0;		/* generate graphs in line */
   g_options.graphgentype = GEN_NOGRAPH;
   g_options.loadgraph_fn[0] = '\0';
   g_options.savegraph_fn[0] = '\0';
@@ -788,6 +922,8 @@ init_options()
   init_graphgen_options();
   init_heuristic_alg_options();
   init_backtrack_alg_options();
+  init_anneal_alg_options();
+  init_learn_alg_options();
 
 }  /* end of init_options() */
 
@@ -810,12 +946,21 @@ print_options(
   {
     case ALG_NOPRUNE_BT:
     case ALG_BACKTRACK:
+    case ALG_DECOMP:
       print_backtrack_alg_options(fp);
       break;
 
     case ALG_POSA_HEUR:
       print_heuristic_alg_options(fp);
       break;
+
+    case ALG_ANNEAL:
+      print_anneal_alg_options(fp);
+      break;
+
+    case ALG_LEARN:
+      print_learn_alg_options(fp);
+      break;
   }  /* end of switch statement */
 
   if (check_word(g_options.loadgraph_fn) != WORD_EMPTY)
@@ -839,6 +984,14 @@ print_options(
   else
      fprintf(fp,"  No Time Limit \n");
 
+  if (g_options.progress_interval > 0)
+     fprintf(fp,"  Progress sampled every %d seconds \n", 
+	g_options.progress_interval);
+
+  if (g_options.pipeline_gens > 0)
+     fprintf(fp,"  Graphs generated ahead by %d processes \n", 
+	g_options.pipeline_gens);
+
   fprintf(fp,"  RNG seed = %d\n", g_options.rng_seed);
 
   fprintf(fp,"  # of tests per graph instance = %d\n", 
@@ -862,6 +1015,10 @@ print_options(
       fprintf(fp," solution ");
     if (g_options.report_flags & REPORT_SUMMARY)
       fprintf(fp," summary ");
+    if (g_options.report_flags & REPORT_HWCOUNTERS)
+      fprintf(fp," hwcounters ");
+    if (g_options.report_flags & REPORT_TREE)
+      fprintf(fp," tree ");
 
     fprintf(fp, "\n");
   }
@@ -28,8 +28,16 @@ typedef struct {
   /* maximum amount of time to let algorithm run for */
   int alg_timelimit;
 
+  /* seconds between progress samples (0 = no sampling) */
+  int progress_interval;
+
+  /* # of graph generator processes (0 = generate in line) */
+  int pipeline_gens;
+
   heuristic_alg_options_type heur_alg;
   backtrack_alg_options_type bt_alg;
+  anneal_alg_options_type anneal_alg;
+  learn_alg_options_type learn_alg;
   
   /* if == GEN_NOGRAPH, then don't generate a graph */
   int graphgentype;
@@ -82,15 +90,21 @@ options_type g_options;
 #define ALG_NOPRUNE_BT	1
 #define ALG_BACKTRACK	2
 #define ALG_POSA_HEUR	3
+#define ALG_ANNEAL	4
+#define ALG_DECOMP	5
+#define ALG_LEARN	6
 
-#define NUM_ALG_OPT	4
+#define NUM_ALG_OPT	7
 
 #ifdef IN_OPTIONS_FILE
 char opt_alg_str[NUM_ALG_OPT][OPTLEN] = {
                 "NOSOLVE",
                 "noprune_bt",
                 "backtrack",
-                "posa_heur" };
+                "posa_heur",
+                "anneal",
+                "decomp",
+                "learn" };
 #else
 extern char opt_alg_str[NUM_ALG_OPT][OPTLEN];
 #endif
@@ -131,6 +145,8 @@ extern char opt_gen_str[NUM_GEN_OPT][OPTLEN];
 #define REPORT_SOLUTION	0x04
 #define REPORT_OPTIONS	0x08
 #define REPORT_SUMMARY	0x10
+#define REPORT_HWCOUNTERS	0x20
+#define REPORT_TREE	0x40
 
 /* savegraph flag */
 #define NOSAVEGRAPH 0
@@ -172,6 +188,8 @@ void parse_parameter_str( char word[], char parmstr[], char valstr[]);
 
 int check_word(char word[]);
 
+void parse_option_stream(FILE *fp);
+
 void parse_option_file(char filename[]);
 
 void init_options();
@@ -0,0 +1,267 @@
+
+
+/* project includes */
+#include "main.h"
+
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+
+/************************************************************/
+/* graph generation pipeline (-pipeline <numgen>)
+ *
+ * numgen generator processes are forked before the first graph is
+ * needed.  generator i makes graphs i, i+numgen, i+2*numgen, ... (with
+ * the +ensureham check, if set) and writes each one as a frame to its own
+ * pipe, while the main process solves the graphs before it.  the pipe
+ * is the bounded queue:  a generator blocks once its pipe is full.
+ *
+ * the generators are separate processes (not threads) since the
+ * generators use the global options and the lrand48() state.  each graph
+ * is generated from its own seed (PIPE_SEED()), so the graphs are the
+ * same for any # of generators, and they are read back in graph order.
+ *
+ * frame:  int graphnum, numvert, ENSURED_* of the graph, # of ints
+ *         following;  deg[0 .. numvert-1], then the neighbours of each
+ *         vertex
+ */
+/************************************************************/
+
+int g_pipenum = 0;			/* # of generators running */
+int g_pipefd[MAXPIPEGENS];		/* read end of each generator's pipe */
+pid_t g_pipepid[MAXPIPEGENS];
+
+
+/************************************************************/
+/* this function writes len bytes to fd.  returns RET_ERROR if the write
+ * failed
+ */
+int
+pipe_write(
+  int fd,
+  void *buf,
+  size_t len)
+{
+  char *pnt = (char *) buf;
+  ssize_t ret;
+
+  while (len > 0)
+  {
+    ret = write(fd, pnt, len);
+    if (ret < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      return(RET_ERROR);
+    }
+    pnt += ret;
+    len -= ret;
+  }
+
+  return(RET_OK);
+
+}  /* end of pipe_write() */
+
+
+/************************************************************/
+/* this function reads len bytes from fd.  returns RET_ERROR on end of
+ * file or error
+ */
+int
+pipe_read(
+  int fd,
+  void *buf,
+  size_t len)
+{
+  char *pnt = (char *) buf;
+  ssize_t ret;
+
+  while (len > 0)
+  {
+    ret = read(fd, pnt, len);
+    if (ret < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      return(RET_ERROR);
+    }
+    if (ret == 0)
+      return(RET_ERROR);
+    pnt += ret;
+    len -= ret;
+  }
+
+  return(RET_OK);
+
+}  /* end of pipe_read() */
+
+
+/************************************************************/
+/* the generator process genid:  generates its share of the graphs and
+ * writes them to fd.  never returns
+ */
+void
+pipeline_generator(
+  int genid,
+  int fd)
+{
+  graph_type *graph = ARENA_NEW(graph_type);
+  int *frame = ARENA_ARRAY(int, 4 + MAXVERT + MAXVERT*MAXDEGREE);
+  int graphnum;
+  int loop, eloop;
+  int len;
+  int ensured;
+
+  /* the log and stats files belong to the main process */
+  g_options.report_flags = REPORT_NONE;
+
+  for (graphnum = genid; graphnum < g_options.num_graph_tests; 
+	graphnum += g_pipenum)
+  {
+    srandom(PIPE_SEED(g_options.rng_seed, graphnum));
+    srand48(PIPE_SEED(g_options.rng_seed, graphnum));
+
+    init_graph(graph);
+    ensured = generate_graph(graph);
+
+    len = 4;
+    for (loop = 0; loop < graph->numvert; loop++)
+      frame[len++] = graph->deg[loop];
+    for (loop = 0; loop < graph->numvert; loop++)
+    {
+      for (eloop = 0; eloop < graph->deg[loop]; eloop++)
+        frame[len++] = graph->nbr[loop][eloop];
+    }
+    frame[0] = graphnum;
+    frame[1] = graph->numvert;
+    frame[2] = ensured;
+    frame[3] = len - 4;
+
+    if (pipe_write(fd, frame, len * sizeof(int)) != RET_OK)
+      _exit(1);
+  }
+
+  close(fd);
+  _exit(0);
+
+}  /* end of pipeline_generator() */
+
+
+/************************************************************/
+/* this function starts the generator processes, if -pipeline is set */
+void
+pipeline_start()
+{
+  int fd[2];
+  int loop, genid;
+  pid_t pid;
+
+  if (g_options.pipeline_gens <= 0)
+    return;
+
+  /* the children must not write out our buffered output again */
+  fflush(NULL);
+
+  g_pipenum = g_options.pipeline_gens;
+  for (loop = 0; loop < g_pipenum; loop++)
+  {
+    if (pipe(fd) != 0)
+    {
+      EXIT_ERROR1("Error creating graph pipeline (%s).\n", strerror(errno));
+    }
+
+    pid = fork();
+    if (pid < 0)
+    {
+      EXIT_ERROR1("Error starting graph generator (%s).\n", strerror(errno));
+    }
+
+    if (pid == 0)
+    {
+      /* the generator only keeps the write end of its own pipe */
+      close(fd[0]);
+      for (genid = 0; genid < loop; genid++)
+        close(g_pipefd[genid]);
+      pipeline_generator(loop, fd[1]);
+    }
+
+    close(fd[1]);
+    g_pipefd[loop] = fd[0];
+    g_pipepid[loop] = pid;
+  }
+
+}  /* end of pipeline_start() */
+
+
+/************************************************************/
+/* this function gets graph # graphnum:  from its generator if the
+ * pipeline is running, otherwise it is generated here.  returns how
+ * +ensureham made the graph hamiltonian (see generate_graph())
+ */
+int
+pipeline_next_graph(
+  graph_type *graph,
+  int graphnum)
+{
+  int header[4];
+  int *frame;
+  int loop, eloop;
+  int len;
+  arena_mark_type mark;
+
+  init_graph(graph);
+
+  if (g_pipenum == 0)
+    return(generate_graph(graph));
+
+  if ( (pipe_read(g_pipefd[graphnum % g_pipenum], header, 
+		sizeof(header)) != RET_OK) ||
+       (header[0] != graphnum) || (header[1] < 0) || (header[1] > MAXVERT) )
+  {
+    EXIT_ERROR1("Error reading graph #%d from the graph pipeline.\n", 
+	graphnum+1);
+  }
+
+  mark = arena_mark();
+  frame = ARENA_ARRAY(int, header[3]);
+  if (pipe_read(g_pipefd[graphnum % g_pipenum], frame, 
+		header[3] * sizeof(int)) != RET_OK)
+  {
+    EXIT_ERROR1("Error reading graph #%d from the graph pipeline.\n", 
+	graphnum+1);
+  }
+
+  graph->numvert = header[1];
+  len = graph->numvert;
+  for (loop = 0; loop < graph->numvert; loop++)
+  {
+    graph->deg[loop] = frame[loop];
+    for (eloop = 0; eloop < graph->deg[loop]; eloop++)
+      graph->nbr[loop][eloop] = frame[len++];
+  }
+  arena_release(mark);
+
+  calc_graph_stats(graph);
+
+  return(header[2]);
+
+}  /* end of pipeline_next_graph() */
+
+
+/************************************************************/
+/* this function closes the pipes, and waits for the generators */
+void
+pipeline_stop()
+{
+  int loop;
+
+  for (loop = 0; loop < g_pipenum; loop++)
+  {
+    close(g_pipefd[loop]);
+    waitpid(g_pipepid[loop], NULL, 0);
+  }
+  g_pipenum = 0;
+
+}  /* end of pipeline_stop() */
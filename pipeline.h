@@ -0,0 +1,35 @@
+
+
+#ifndef _PIPELINE_H_
+#define _PIPELINE_H_
+
+
+/************************************************************/
+/* defines and data structures */
+/************************************************************/
+
+/* the most generator processes (-pipeline) */
+#define MAXPIPEGENS	16
+
+/* the seed for generating graph # k is PIPE_SEED(rng seed, k), so that
+ * the graphs don't depend on the # of generators
+ */
+#define PIPE_SEED(seed,k)	((long) (seed) + 7919L * ((k) + 1))
+
+
+/************************************************************/
+/* function declarations */
+/************************************************************/
+
+int pipe_write( int fd, void *buf, size_t len);
+
+int pipe_read( int fd, void *buf, size_t len);
+
+void pipeline_start();
+
+int pipeline_next_graph( graph_type *graph, int graphnum);
+
+void pipeline_stop();
+
+#endif /* _PIPELINE_H_ */
+
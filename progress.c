@@ -0,0 +1,173 @@
+
+#define IN_PROGRESS_FILE
+
+/* project includes */
+#include "main.h"
+
+#include <errno.h>
+#include <pthread.h>
+
+
+/************************************************************/
+/* live progress sampling (-progress <sec>)
+ *
+ * a separate thread wakes up every <sec> seconds and appends a snapshot
+ * of g_progress (and the node rate since the last snapshot) to the
+ * .progress file, so long running trials can be watched (and killed if
+ * hopeless) while they run.  the search thread only updates g_progress,
+ * it never waits for the sampler.
+ */
+/************************************************************/
+
+pthread_t g_progress_thread;
+pthread_mutex_t g_progress_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t g_progress_wake = PTHREAD_COND_INITIALIZER;
+int g_progress_running = 0;	/* protected by g_progress_lock */
+
+FILE *g_progress_fp = NULL;
+
+
+/************************************************************/
+/* returns the current (monotonic) clock time, in seconds */
+double
+progress_clock()
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return(ts.tv_sec + ts.tv_nsec * 1e-9);
+
+}  /* end of progress_clock() */
+
+
+/************************************************************/
+/* the sampling thread.  takes a snapshot every progress_interval
+ * seconds till progress_stop() is called
+ */
+void *
+progress_sampler(
+  void *arg)
+{
+  struct timespec waketime;
+  double start, now, lasttime;
+  long long nodes, lastnodes = 0;
+  int graph, trial;
+  int lastgraph = 0, lasttrial = 0;
+  float rate;
+
+  start = lasttime = progress_clock();
+  clock_gettime(CLOCK_REALTIME, &waketime);
+
+  pthread_mutex_lock(&g_progress_lock);
+  while (g_progress_running)
+  {
+    waketime.tv_sec += g_options.progress_interval;
+    while ( (g_progress_running) &&
+	    (pthread_cond_timedwait(&g_progress_wake, &g_progress_lock,
+		&waketime) != ETIMEDOUT) )
+      ;
+    if (!g_progress_running)
+      break;
+
+    graph = PROGRESS_LOAD(graph);
+    trial = PROGRESS_LOAD(trial);
+    nodes = PROGRESS_LOAD(nodes);
+    now = progress_clock();
+
+    /* the node count starts again at each trial */
+    if ( (graph != lastgraph) || (trial != lasttrial) )
+      lastnodes = 0;
+    rate = (now > lasttime) ? (nodes - lastnodes) / (now - lasttime) : 0.0;
+
+    fprintf(g_progress_fp, "%.1f\t%d\t%d\t%lld\t%.0f\t%d\t%d\t%d\n",
+	now - start, graph, trial, nodes, rate, PROGRESS_LOAD(pathlen),
+	PROGRESS_LOAD(maxpath), PROGRESS_LOAD(restart));
+    fflush(g_progress_fp);
+
+    lastnodes = nodes;
+    lastgraph = graph;
+    lasttrial = trial;
+    lasttime = now;
+  }
+  pthread_mutex_unlock(&g_progress_lock);
+
+  return(NULL);
+
+}  /* end of progress_sampler() */
+
+
+/************************************************************/
+/* this function opens the .progress file and starts the sampling
+ * thread.  if the thread can't be started, the run continues without
+ * progress samples
+ */
+void
+progress_start()
+{
+  char filename[STRLEN];
+
+  strcpy(filename, g_options.output_fn);
+  strcat(filename, ".progress");
+  g_progress_fp = fopen(filename, "w");
+  if (g_progress_fp == NULL)
+  {
+    WARN_ERROR1("Error opening progress file `%s' for writing.\n", filename);
+    return;
+  }
+  printf("Progress samples written to `%s'.\n", filename);
+  fprintf(g_progress_fp, "Time\tGraph\tTrial\tNodes\tNodes/sec\t"
+	"PathLen\tMaxPath\tRestart\n");
+  fflush(g_progress_fp);
+
+  memset(&g_progress, 0, sizeof(g_progress));
+
+  g_progress_running = 1;
+  if (pthread_create(&g_progress_thread, NULL, progress_sampler, NULL) != 0)
+  {
+    WARN_ERROR("Warning:  could not start the progress thread.\n");
+    g_progress_running = 0;
+    fclose(g_progress_fp);
+    g_progress_fp = NULL;
+  }
+
+}  /* end of progress_start() */
+
+
+/************************************************************/
+/* this function clears the progress counters at the start of a trial */
+void
+progress_trial(
+  int graphnum,
+  int trialnum)
+{
+  PROGRESS_STORE(nodes, 0);
+  PROGRESS_STORE(pathlen, 0);
+  PROGRESS_STORE(maxpath, 0);
+  PROGRESS_STORE(restart, 0);
+  PROGRESS_STORE(graph, graphnum);
+  PROGRESS_STORE(trial, trialnum);
+
+}  /* end of progress_trial() */
+
+
+/************************************************************/
+/* this function stops the sampling thread and closes the .progress file
+ */
+void
+progress_stop()
+{
+  if (g_progress_fp == NULL)
+    return;
+
+  pthread_mutex_lock(&g_progress_lock);
+  g_progress_running = 0;
+  pthread_cond_signal(&g_progress_wake);
+  pthread_mutex_unlock(&g_progress_lock);
+
+  pthread_join(g_progress_thread, NULL);
+
+  fclose(g_progress_fp);
+  g_progress_fp = NULL;
+
+}  /* end of progress_stop() */
+
@@ -0,0 +1,54 @@
+
+
+#ifndef _PROGRESS_H_
+#define _PROGRESS_H_
+
+
+/************************************************************/
+/* defines and data structures */
+/************************************************************/
+
+/* state of the running trial, written by the search and read by the
+ * sampling thread (-progress).  all accesses use relaxed atomics: the
+ * search only pays for plain loads and stores, and the samples don't
+ * need to be consistent with each other
+ */
+typedef struct {
+  long long nodes;	/* nodes (moves for annealing) in the trial */
+  int pathlen;		/* current path length */
+  int maxpath;		/* longest path reached in the trial */
+  int restart;		/* restart iteration, or posa start vertex */
+  int graph;		/* current graph # */
+  int trial;		/* current trial # */
+  }  progress_type;
+
+#ifdef IN_PROGRESS_FILE
+progress_type g_progress;
+#else
+extern progress_type g_progress;
+#endif
+
+#define PROGRESS_STORE(field,val) \
+	__atomic_store_n(&(g_progress.field), (val), __ATOMIC_RELAXED)
+#define PROGRESS_LOAD(field) \
+	__atomic_load_n(&(g_progress.field), __ATOMIC_RELAXED)
+
+/* called by the search for each node, with the current path length */
+#define PROGRESS_NODE(len) { \
+	PROGRESS_STORE(nodes, PROGRESS_LOAD(nodes) + 1); \
+	PROGRESS_STORE(pathlen, (len)); \
+	if ((len) > PROGRESS_LOAD(maxpath)) PROGRESS_STORE(maxpath, (len)); }
+
+
+/************************************************************/
+/* function declarations */
+/************************************************************/
+
+void progress_start();
+
+void progress_trial( int graphnum, int trialnum);
+
+void progress_stop();
+
+#endif /* _PROGRESS_H_ */
+
@@ -6,6 +6,20 @@
 #include "main.h"
 
 
+/* phase timer state:  the current phase, when it was last switched to,
+ * and the time so far in each phase of the current trial
+ */
+int g_curphase = PHASE_OTHER;
+phase_tick_type g_phasestart = 0;
+phase_tick_type g_phasetime[NUM_PHASES];
+
+/* clock and tick count at the start of the trial, to convert ticks to
+ * seconds at the end of the trial 
+ */
+double g_phasewall0 = 0.0;
+phase_tick_type g_phasetick0 = 0;
+
+
 /************************************************************/
 /* basic statistical calculation functions
  *
@@ -231,6 +245,82 @@ calc_node_stats(
 }  /* end of calc_node_stats() */
   
 
+/************************************************************/
+/* this function calculates the phase time statistics, over all trials 
+ */
+void
+calc_phase_stats(
+  stat_exp_type *stats)
+{
+  int gloop, tloop, ploop;
+  int count;
+  float min, max;	/* junk variables */
+  float list[g_options.num_graph_tests * g_options.num_instance_tests + 1];
+
+  for (ploop = 0; ploop < NUM_PHASES; ploop++)
+  {
+    count = 0;
+    for (gloop = 0; gloop < g_options.num_graph_tests; gloop++)
+    {
+      for (tloop = 0; tloop < g_options.num_instance_tests; tloop++)
+      {
+        list[count++] = stats->graph[gloop].trial[tloop].phasetime[ploop];
+      }
+    }
+
+    calc_flist_stats(list, count, &(stats->phasetime[ploop].ave),
+	&(stats->phasetime[ploop].stddev), &min, &max);
+  }
+
+}  /* end of calc_phase_stats() */
+
+
+/************************************************************/
+/* this function calculates the hardware counter statistics (instructions
+ * per cycle, and misses per node), over the trials that have them
+ */
+void
+calc_hw_stats(
+  stat_exp_type *stats)
+{
+  int gloop, tloop, hloop;
+  int count;
+  float min, max;	/* junk variables */
+  stat_pertrial_type *trial;
+  float list[g_options.num_graph_tests * g_options.num_instance_tests + 1];
+
+  for (hloop = HW_INSTR; hloop < NUM_HWCOUNTERS; hloop++)
+  {
+    count = 0;
+    for (gloop = 0; gloop < g_options.num_graph_tests; gloop++)
+    {
+      for (tloop = 0; tloop < g_options.num_instance_tests; tloop++)
+      {
+        trial = &(stats->graph[gloop].trial[tloop]);
+        if ( (trial->hwcount[HW_CYCLES] <= 0) || 
+             (trial->hwcount[hloop] == HW_NOCOUNT) )
+          continue;
+
+        if (hloop == HW_INSTR)
+          list[count++] = (float) trial->hwcount[HW_INSTR] / 
+			(float) trial->hwcount[HW_CYCLES];
+        else
+          list[count++] = (float) trial->hwcount[hloop] / 
+			(float) ((trial->nodes > 0) ? trial->nodes : 1);
+      }
+    }
+
+    stats->hwtrials[hloop] = count;
+    if (count > 0)
+    {
+      calc_flist_stats(list, count, &(stats->hwstat[hloop].ave), 
+	&(stats->hwstat[hloop].stddev), &min, &max);
+    }
+  }
+
+}  /* end of calc_hw_stats() */
+
+
 /************************************************************/
 /* this function calculates the statistics after all the experiments are 
  * complete
@@ -269,7 +359,8 @@ calc_exp_stats(
   int numhamgraphs = g_options.num_graph_tests;
 
   /* heuristic algorithm */
-  if (g_options.algorithm == ALG_POSA_HEUR)
+  if ( (g_options.algorithm == ALG_POSA_HEUR) ||
+        (g_options.algorithm == ALG_ANNEAL) )
   {
     /* note that HC_NOT_EXIST results are completely ignored */
     for (gloop = 0; gloop < g_options.num_graph_tests; gloop++)
@@ -335,7 +426,9 @@ calc_exp_stats(
 
   /* backtrack algorithm */
   else if ( (g_options.algorithm == ALG_NOPRUNE_BT) ||
-        (g_options.algorithm == ALG_BACKTRACK) )
+        (g_options.algorithm == ALG_BACKTRACK) ||
+        (g_options.algorithm == ALG_DECOMP) ||
+        (g_options.algorithm == ALG_LEARN) )
   {
     /* only ignore HC_NOT_FOUND if graph is HC_NOT_FOUND */
     /* always include HC_NOT_FOUND results for tottime stats */
@@ -446,6 +539,10 @@ calc_exp_stats(
 
   calc_node_stats(stats);
 
+  calc_phase_stats(stats);
+
+  calc_hw_stats(stats);
+
 }  /* end of calc_exp_stats() */
 
 
@@ -456,7 +553,10 @@ void
 init_exp_stats(
   stat_exp_type *stats)
 {
-  int gloop, tloop;
+  int gloop, tloop, ploop;
+
+  for (ploop = 0; ploop < NUM_HWCOUNTERS; ploop++)
+    stats->hwtrials[ploop] = 0;
 
   for (gloop = 0; gloop < g_options.num_graph_tests; gloop++)
   {
@@ -468,9 +568,134 @@ init_exp_stats(
       stats->graph[gloop].trial[tloop].edgeprune = 0;
       stats->graph[gloop].trial[tloop].initprune = 0;
       stats->graph[gloop].trial[tloop].retries = 0;
+      for (ploop = 0; ploop < NUM_PHASES; ploop++)
+        stats->graph[gloop].trial[tloop].phasetime[ploop] = 0;
+      for (ploop = 0; ploop < NUM_HWCOUNTERS; ploop++)
+        stats->graph[gloop].trial[tloop].hwcount[ploop] = HW_NOCOUNT;
+      stats->graph[gloop].trial[tloop].hccount = -1;
+      stats->graph[gloop].trial[tloop].countexact = COUNT_EXACT;
     }
     stats->graph[gloop].graphham = HC_NOT_FOUND;
+    stats->graph[gloop].ensured = ENSURED_NONE;
   }
 
 }  /* end of init_exp_stats() */
 
+
+/************************************************************/
+/* phase timing functions
+ *
+ */
+/************************************************************/
+
+/************************************************************/
+/* returns the current (monotonic) clock time, in seconds */
+double
+phase_clock()
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return(ts.tv_sec + ts.tv_nsec * 1e-9);
+
+}  /* end of phase_clock() */
+
+
+/************************************************************/
+/* returns the current tick count.  this is the time stamp counter on
+ * x86 (much cheaper than a clock call, which matters as the timers are
+ * switched several times per search node), otherwise the clock in 
+ * nanoseconds
+ */
+phase_tick_type
+phase_ticks()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  return(__builtin_ia32_rdtsc());
+#else
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return((phase_tick_type) ts.tv_sec * 1000000000 + ts.tv_nsec);
+#endif
+
+}  /* end of phase_ticks() */
+
+
+/************************************************************/
+/* this function stops the clock of the current phase, and starts the
+ * clock of the specified phase.  returns the phase that was stopped
+ * (so that it can be switched back to)
+ */
+int
+phase_switch(
+  int phase)
+{
+  phase_tick_type now = phase_ticks();
+  int oldphase = g_curphase;
+
+  g_phasetime[g_curphase] += now - g_phasestart;
+  g_phasestart = now;
+  g_curphase = phase;
+
+  return(oldphase);
+
+}  /* end of phase_switch() */
+
+
+/************************************************************/
+/* this function clears the phase times, at the start of a trial */
+void
+phase_reset()
+{
+  int loop;
+
+  for (loop = 0; loop < NUM_PHASES; loop++)
+    g_phasetime[loop] = 0;
+
+  g_curphase = PHASE_OTHER;
+  g_phasewall0 = phase_clock();
+  g_phasetick0 = g_phasestart = phase_ticks();
+
+}  /* end of phase_reset() */
+
+
+/************************************************************/
+/* this function saves the phase times of the trial just finished */
+void
+phase_save(
+  stat_pertrial_type *trialstats)
+{
+  int loop;
+  double secpertick = 0.0;
+
+  phase_switch(g_curphase);
+
+  /* calibrate the ticks against the clock over the whole trial */
+  if (g_phasestart > g_phasetick0)
+  {
+    secpertick = (phase_clock() - g_phasewall0) / 
+			(double) (g_phasestart - g_phasetick0);
+  }
+
+  for (loop = 0; loop < NUM_PHASES; loop++)
+    trialstats->phasetime[loop] = g_phasetime[loop] * secpertick;
+
+}  /* end of phase_save() */
+
+
+/************************************************************/
+/* this function prints the phase times of a trial */
+void
+print_phase_times(
+  FILE *fp,
+  float phasetime[])
+{
+  int loop;
+
+  fprintf(fp, "Phase times (sec):");
+  for (loop = 0; loop < NUM_PHASES; loop++)
+    fprintf(fp, "  %s %.4f", phase_str[loop], phasetime[loop]);
+  fprintf(fp, "\n");
+
+}  /* end of print_phase_times() */
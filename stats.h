@@ -17,6 +17,77 @@
 #define MAXTRIALTESTS 10
 #define MAXGRAPHTESTS 10000
 
+/* per-phase timing of each trial (wall clock).  compile with 
+ * -DPHASE_TIMING=0 to remove the timers
+ */
+#ifndef PHASE_TIMING
+#define PHASE_TIMING 1
+#endif
+
+/* phases of a trial.  phase times are exclusive:  a phase started 
+ * inside another one stops the clock of the outer phase till it ends
+ */
+#define PHASE_OTHER	0	/* set up, and anything not in the phases below */
+#define PHASE_INITPRUNE	1	/* initial pruning of the graph */
+#define PHASE_COPY	2	/* copying graphs */
+#define PHASE_SEARCH	3	/* the search itself */
+#define PHASE_PRUNE	4	/* pruning during the search */
+#define PHASE_CHECK	5	/* component, cutpoint, reachability checks */
+#define PHASE_CLOSE	6	/* converting a hamiltonian path to a cycle */
+#define PHASE_VERIFY	7	/* verifying the solution */
+#define NUM_PHASES	8
+
+#ifdef IN_STATS_FILE
+char phase_str[NUM_PHASES][STRLEN] = {
+		"other",
+		"initprune",
+		"copy",
+		"search",
+		"prune",
+		"check",
+		"close",
+		"verify" };
+#else
+extern char phase_str[NUM_PHASES][STRLEN];
+#endif
+
+/* timer macros:  PHASE_START(x) and PHASE_STOP(x) must be in the same
+ * block, and every return in between must be preceded by PHASE_STOP(x)
+ */
+/* tick counts used by the timers (converted to seconds per trial) */
+typedef unsigned long long phase_tick_type;
+
+#if PHASE_TIMING
+#define PHASE_START(phase)	int prevphase_##phase = phase_switch(phase)
+#define PHASE_STOP(phase)	phase_switch(prevphase_##phase)
+#else
+#define PHASE_START(phase)
+#define PHASE_STOP(phase)
+#endif
+
+/* hardware performance counters recorded per trial 
+ * (-report +hwcounters).  a count of HW_NOCOUNT means not available
+ */
+#define HW_CYCLES	0
+#define HW_INSTR	1
+#define HW_L1MISS	2	/* L1 data cache read misses */
+#define HW_LLCMISS	3	/* last level cache misses */
+#define HW_BRMISS	4	/* branch mispredicts */
+#define NUM_HWCOUNTERS	5
+
+#define HW_NOCOUNT	(-1)
+
+#ifdef IN_STATS_FILE
+char hwcounter_str[NUM_HWCOUNTERS][STRLEN] = {
+		"cycles",
+		"instructions",
+		"L1-misses",
+		"LLC-misses",
+		"branch-misses" };
+#else
+extern char hwcounter_str[NUM_HWCOUNTERS][STRLEN];
+#endif
+
 
 typedef struct {
   float ave;
@@ -30,6 +101,10 @@ typedef struct {
   int edgeprune;
   int initprune;
   int retries;
+  float phasetime[NUM_PHASES];
+  long long hwcount[NUM_HWCOUNTERS];
+  long long hccount;	/* # of hamiltonian cycles (+count), -1 if not counted */
+  int countexact;	/* COUNT_EXACT, COUNT_CAPPED or COUNT_PARTIAL */
   } stat_pertrial_type;
 
 typedef struct {
@@ -37,6 +112,7 @@ typedef struct {
   int graphham;    /* = HC_FOUND, HC_NOT_FOUND, HC_NOT_EXIST */
   int biconnected;	/* = 1 if biconnected, = 0 if not */
   int mindeg2;		/* = 1 if min degree >= 2, = 0 if not */
+  int ensured;		/* how +ensureham made it hamiltonian (ENSURED_*) */
   } stat_pergraph_type;
 
 typedef struct {
@@ -67,6 +143,16 @@ typedef struct {
   stat_type perbiconnect;
   stat_type permindeg2;
 
+  /* time per phase, over all trials */
+  stat_type phasetime[NUM_PHASES];
+
+  /* hardware counters, over the trials that have them:  instructions
+   * per cycle (in the HW_INSTR entry), and misses per node (in the
+   * entries of the miss counters)
+   */
+  stat_type hwstat[NUM_HWCOUNTERS];
+  int hwtrials[NUM_HWCOUNTERS];	/* # of trials with the counter available */
+
   } stat_exp_type;
 
 
@@ -85,5 +171,13 @@ void calc_exp_stats( stat_exp_type *stats);
 
 void init_exp_stats( stat_exp_type *stats);
 
+int phase_switch( int phase);
+
+void phase_reset();
+
+void phase_save( stat_pertrial_type *trialstats);
+
+void print_phase_times( FILE *fp, float phasetime[]);
+
 #endif /* _STATS_H_ */
 
@@ -41,10 +41,12 @@ print_experiment_summary(
       break;
 
     case GEN_RANDOM:
-      if (g_options.graphgen.makeham != HAM_ENSURE)
-        sprintf(expstr, "ra%d", g_options.graphgen.nvertex);
-      else
+      if (g_options.graphgen.makeham == HAM_ENSURE)
         sprintf(expstr, "rah%d", g_options.graphgen.nvertex);
+      else if (g_options.graphgen.makeham == HAM_FAST)
+        sprintf(expstr, "raf%d", g_options.graphgen.nvertex);
+      else
+        sprintf(expstr, "ra%d", g_options.graphgen.nvertex);
 
       if (g_options.graphgen.degconst > 0.0)
         sprintf(tmpstr, "d%.3f", g_options.graphgen.degconst);
@@ -59,10 +61,12 @@ print_experiment_summary(
       break;
 
     case GEN_DEGREEBOUND:
-      if (g_options.graphgen.makeham != HAM_ENSURE)
-        sprintf(expstr, "db%d", g_options.graphgen.nvertex);
-      else
+      if (g_options.graphgen.makeham == HAM_ENSURE)
         sprintf(expstr, "dbh%d", g_options.graphgen.nvertex);
+      else if (g_options.graphgen.makeham == HAM_FAST)
+        sprintf(expstr, "dbf%d", g_options.graphgen.nvertex);
+      else
+        sprintf(expstr, "db%d", g_options.graphgen.nvertex);
 
       for (loop = 2; loop <= g_options.graphgen.degsize; loop++)
       {
@@ -112,7 +116,11 @@ print_experiment_summary(
       break;
 
     case ALG_BACKTRACK:
-      strcat(expstr, "ba");
+    case ALG_DECOMP:
+      if (g_options.algorithm == ALG_DECOMP)
+        strcat(expstr, "dc");
+      else
+        strcat(expstr, "ba");
       if (g_options.bt_alg.restart_increment > 1)
       {
         sprintf(tmpstr, "i%d", g_options.bt_alg.restart_increment);
@@ -147,6 +155,15 @@ print_experiment_summary(
         case DEGSORT_MAX:
           strcat(expstr, "d");
           break;
+        case DEGSORT_UNVISIT:
+          strcat(expstr, "u");
+          break;
+        case DEGSORT_FORCE:
+          strcat(expstr, "f");
+          break;
+        case DEGSORT_CONFLICT:
+          strcat(expstr, "w");
+          break;
       }
 
       /* graph pruning/checking options */
@@ -158,6 +175,8 @@ print_experiment_summary(
         strcat(expstr, "o");
       if (g_options.bt_alg.pruneoptflag & HC_PRUNE_CUTPOINT)
         strcat(expstr, "a");
+      if (g_options.bt_alg.pruneoptflag & HC_PRUNE_REACH)
+        strcat(expstr, "r");
 
       break;
 
@@ -181,6 +200,14 @@ print_experiment_summary(
         strcat(expstr, "c");
       break;
 
+    case ALG_ANNEAL:
+      strcat(expstr, "an");
+      break;
+
+    case ALG_LEARN:
+      strcat(expstr, "le");
+      break;
+
   }  /* end of switch statment for algorithms */
 
   /* add separator */
@@ -199,6 +226,90 @@ print_experiment_summary(
 }  /* end of print_experiment_summary() */
 
 
+/************************************************************/
+/* this function prints out the information for the summary file
+ * if printflag == PRINT_INFO_HEADER then just the header is printed
+ * otherwise everything is printed
+ */
+void
+print_info_summary(
+  stat_exp_type *stats,
+  FILE *fp,
+  int printflag)
+{
+  char sumstr[STRLEN];
+ 
+  print_experiment_summary(sumstr);
+
+  /* note that if multiple graphs tested, additional information
+   * is printed out (after normal information)
+   */
+ 
+  /* print out header */
+  fprintf(fp, "%30s", "Experiment");
+
+  if ( (g_options.algorithm == ALG_POSA_HEUR) ||
+        (g_options.algorithm == ALG_ANNEAL) )
+  {
+    /* print heuristic stats */
+    fprintf(fp, "\t%% ham graph");
+    fprintf(fp, "\talg success");
+    fprintf(fp, "\texpected time");
+  }
+  else
+  if ( (g_options.algorithm == ALG_NOPRUNE_BT) ||
+        (g_options.algorithm == ALG_BACKTRACK) ||
+        (g_options.algorithm == ALG_DECOMP) ||
+        (g_options.algorithm == ALG_LEARN) )
+  {
+    /* print backtrack stats */
+    fprintf(fp, "\t%% ham graph");
+    fprintf(fp, "\talg success");
+    fprintf(fp, "\texpected time");
+  }
+  else
+  {
+    /* print combination */
+    fprintf(fp, "\t%% ham graph");
+    fprintf(fp, "\talg success");
+    fprintf(fp, "\texpected time");
+  }
+
+  fprintf(fp, "\n");
+
+  if (printflag == PRINT_INFO_HEADER)
+    return;
+
+  /* print out information */
+  fprintf(fp, "%30s", sumstr);
+
+  if ( (g_options.algorithm == ALG_POSA_HEUR) ||
+        (g_options.algorithm == ALG_ANNEAL) )
+  {
+    /* print heuristic stats */
+    fprintf(fp, "\t%.1f %%    ", stats->perham.ave*100);
+    fprintf(fp, "\t%.1f %%    ", stats->algsuccess.ave*100);
+    fprintf(fp, "\t%.1f (%.1f)", stats->tmexpect.ave,
+	stats->tmexpect.stddev);
+  }
+  else
+  if ( (g_options.algorithm == ALG_NOPRUNE_BT) ||
+        (g_options.algorithm == ALG_BACKTRACK) ||
+        (g_options.algorithm == ALG_DECOMP) ||
+        (g_options.algorithm == ALG_LEARN) )
+  {
+    /* print backtrack stats */
+    fprintf(fp, "\t%.1f %%    ", stats->perham.ave*100);
+    fprintf(fp, "\t%.1f %%    ", stats->algsuccess.ave*100);
+    fprintf(fp, "\t%.1f (%.1f)", stats->tmexpect.ave,
+	stats->tmexpect.stddev);
+  }
+
+  fprintf(fp, "\n");
+
+}  /* end of print_info_summary() */
+
+
 /************************************************************/
 /*  this function reads the next experiment string from the specified file
  *  skipping any comments that are encounteredd
@@ -411,15 +522,19 @@ parse_experiment_string_for_options(
       break;
 
     case GEN_RANDOM:
-      /* check for hamiltonicity flag */
-      if (expstr[index] == 'h')
+      /* check for hamiltonicity flag (h, or f for +ensureham=fast) */
+      if ( (expstr[index] == 'h') || (expstr[index] == 'f') )
       {
         index += get_substring(str, expstr, index, 1);
-        if (str[0] != 'h')
+        if (str[0] == 'h')
+          g_options.graphgen.makeham = HAM_ENSURE;
+        else if (str[0] == 'f')
+          g_options.graphgen.makeham = HAM_FAST;
+        else
         {
-          EXIT_ERROR1("Error reading `h' flag in experiment `%s'.\n",expstr);
+          EXIT_ERROR1("Error reading `h' or `f' flag in experiment `%s'.\n",
+		expstr);
         }
-        g_options.graphgen.makeham = HAM_ENSURE;
       }
 
       /* get # of vertices */
@@ -452,15 +567,19 @@ parse_experiment_string_for_options(
 
     case GEN_DEGREEBOUND:
 
-      /* check for hamiltonicity flag */
-      if (expstr[index] == 'h')
+      /* check for hamiltonicity flag (h, or f for +ensureham=fast) */
+      if ( (expstr[index] == 'h') || (expstr[index] == 'f') )
       {
         index += get_substring(str, expstr, index, 1);
-        if (str[0] != 'h')
+        if (str[0] == 'h')
+          g_options.graphgen.makeham = HAM_ENSURE;
+        else if (str[0] == 'f')
+          g_options.graphgen.makeham = HAM_FAST;
+        else
         {
-          EXIT_ERROR1("Error reading `h' flag in experiment `%s'.\n",expstr);
+          EXIT_ERROR1("Error reading `h' or `f' flag in experiment `%s'.\n",
+		expstr);
         }
-        g_options.graphgen.makeham = HAM_ENSURE;
       }
 
       /* get # of vertices */
@@ -569,6 +688,21 @@ parse_experiment_string_for_options(
   {
     g_options.algorithm = ALG_POSA_HEUR;
   }
+  else 
+  if (strcasecmp(str, "an") == 0)
+  {
+    g_options.algorithm = ALG_ANNEAL;
+  }
+  else 
+  if (strcasecmp(str, "dc") == 0)
+  {
+    g_options.algorithm = ALG_DECOMP;
+  }
+  else 
+  if (strcasecmp(str, "le") == 0)
+  {
+    g_options.algorithm = ALG_LEARN;
+  }
   else
   {
     fprintf(stderr, "Unrecognized algorithm type `%s' in "
@@ -580,6 +714,7 @@ parse_experiment_string_for_options(
   switch(g_options.algorithm)
   {
     case ALG_BACKTRACK:
+    case ALG_DECOMP:
       /* set default options */
       init_backtrack_alg_options();
 
@@ -635,6 +770,12 @@ parse_experiment_string_for_options(
         g_options.bt_alg.degsortflag = DEGSORT_MIN;
       else if (str[0] == 'd')
         g_options.bt_alg.degsortflag = DEGSORT_MAX;
+      else if (str[0] == 'u')
+        g_options.bt_alg.degsortflag = DEGSORT_UNVISIT;
+      else if (str[0] == 'f')
+        g_options.bt_alg.degsortflag = DEGSORT_FORCE;
+      else if (str[0] == 'w')
+        g_options.bt_alg.degsortflag = DEGSORT_CONFLICT;
       else
       {
         fprintf(stderr, "Bad option %c specified for pruning ", str[0]);
@@ -668,6 +809,9 @@ parse_experiment_string_for_options(
           case 'a':
             g_options.bt_alg.pruneoptflag |= HC_PRUNE_CUTPOINT;
             break;
+          case 'r':
+            g_options.bt_alg.pruneoptflag |= HC_PRUNE_REACH;
+            break;
           default:
             fprintf(stderr, "Unrecognized pruning backtrack option `%c' in "
   		    "experiment `%s'.\n", str[0], expstr);
@@ -722,6 +866,16 @@ parse_experiment_string_for_options(
       }  /* end of parse-heuristic-options loop */
       break;
 
+    case ALG_ANNEAL:
+      /* no options, annealing parameters are left at their defaults */
+      init_anneal_alg_options();
+      break;
+
+    case ALG_LEARN:
+      /* no options, learning search parameters are left at their defaults */
+      init_learn_alg_options();
+      break;
+
   }  /* end of switch statement for parsing algorithm options */
 
   /* finished parsing algorithm, read in separator */
@@ -810,8 +964,13 @@ create_opt_file(
       break;
 
     case GEN_RANDOM:
-      fprintf(fp, "\n-graphgen random +nvertex=%d ",
-	g_options.graphgen.nvertex);
+      fprintf(fp, "\n-graphgen random");
+      if (g_options.graphgen.makeham == HAM_ENSURE)
+        fprintf(fp, " +ensureham");
+      else if (g_options.graphgen.makeham == HAM_FAST)
+        fprintf(fp, " +ensureham=fast");
+
+      fprintf(fp, " +nvertex=%d ", g_options.graphgen.nvertex);
       if (g_options.graphgen.degconst > 0.0)
         fprintf(fp, "+degconst=%.3f", g_options.graphgen.degconst);
       else
@@ -827,6 +986,8 @@ create_opt_file(
       fprintf(fp, "\n-graphgen degreebound");
       if (g_options.graphgen.makeham == HAM_ENSURE)
         fprintf(fp, " +ensureham");
+      else if (g_options.graphgen.makeham == HAM_FAST)
+        fprintf(fp, " +ensureham=fast");
 
       fprintf(fp, " +nvertex=%d", g_options.graphgen.nvertex);
 
@@ -869,8 +1030,17 @@ create_opt_file(
       fprintf(fp, "\n-algorithm noprune_bt");
       break;
 
+    case ALG_ANNEAL:
+      fprintf(fp, "\n-algorithm anneal");
+      break;
+
+    case ALG_LEARN:
+      fprintf(fp, "\n-algorithm learn");
+      break;
+
     case ALG_BACKTRACK:
-      fprintf(fp, "\n-algorithm backtrack");
+    case ALG_DECOMP:
+      fprintf(fp, "\n-algorithm %s", opt_alg_str[g_options.algorithm]);
 
       if (g_options.bt_alg.restart_increment > 1)
       {
@@ -901,6 +1071,15 @@ create_opt_file(
         case DEGSORT_MIN:
           fprintf(fp, " +degsort=min");
           break;
+        case DEGSORT_UNVISIT:
+          fprintf(fp, " +degsort=unvisited");
+          break;
+        case DEGSORT_FORCE:
+          fprintf(fp, " +degsort=forcing");
+          break;
+        case DEGSORT_CONFLICT:
+          fprintf(fp, " +degsort=conflict");
+          break;
       }
 
       if (g_options.bt_alg.pruneoptflag != HC_PRUNE_NONE)
@@ -914,6 +1093,8 @@ create_opt_file(
           fprintf(fp, "O");
         if (g_options.bt_alg.pruneoptflag & HC_PRUNE_CUTPOINT)
           fprintf(fp, "A");
+        if (g_options.bt_alg.pruneoptflag & HC_PRUNE_REACH)
+          fprintf(fp, "R");
       }
       break;
   }
@@ -3,6 +3,13 @@
 
 #ifndef _TESTER_H_
 #define _TESTER_H_
+
+/* defines for print_info_summary() function */
+#define PRINT_INFO_HEADER 	0
+#define PRINT_INFO_ALL 		1
+
+void print_info_summary( stat_exp_type *stats, FILE *fp, int printflag);
+
 void print_experiment_summary( char expstr[]);
 
 void do_automated_testing( char progname[]);